@@ -0,0 +1,360 @@
+////////////////  Developed By Hamid.Memar (2023-Revised)  ////////////////
+///////////////   Licensed Under MIT Terms And Arguments   ////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace AnimatedCaches
+{
+    // Frame codecs
+    constexpr uint32_t CodecRaw = 0;            // Positions then normals, as captured
+    constexpr uint32_t CodecKey = 1;            // Lossless floats, starts a delta chain
+    constexpr uint32_t CodecDelta = 2;          // Quantized difference to the previous decoded frame
+    constexpr uint32_t CodecBasisKey = 3;       // Mean and basis of a segment, plus the frame's coefficients
+    constexpr uint32_t CodecBasis = 4;          // Coefficients against the segment's basis
+
+    // Header flags
+    constexpr uint32_t CacheNormals = 0x1;      // Every frame carries nNum normals after its positions
+
+    // Fixed header at the start of a .mxa file
+    struct CacheHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t flags;
+        uint32_t frameCount;
+        int32_t vNum;
+        int32_t nNum;
+        int32_t startTime;          // Ticks of the first frame
+        int32_t stepTime;           // Ticks between frames
+        uint64_t topologyHash;      // Fingerprint of the cached topology, 0 when unknown
+        uint64_t topologyOffset;    // Embedded .mxo package of the first frame
+        uint64_t topologySize;
+        uint64_t frameTableOffset;
+        uint32_t codec;             // Codec the frames were encoded with, version 2 and later
+        uint32_t keyInterval;       // Frames per delta chain or basis segment
+        float positionStep;         // Delta quantization steps
+        float normalStep;
+        float maxError;             // Worst vertex distance of the decoded frames, scene units
+        float rmsError;
+        uint64_t reserved[1];
+    };
+
+    // One frame of the offset table
+    struct FrameRecord
+    {
+        int32_t time;
+        uint32_t codec;
+        uint64_t offset;
+        uint64_t size;              // Stored bytes
+        uint64_t rawSize;           // Decoded bytes
+    };
+
+    // Last frame at or before the time, clamped to the cached range
+    size_t FindFrame(const FrameRecord* frames, size_t count, int32_t time) noexcept;
+
+    // Topology and UVs once as an embedded package, then a vertex stream per frame.
+    // Frames are appended as they are captured and indexed by a table written on
+    // Close(), so readers seek straight to any frame. The file is written under a
+    // temporary name and renamed, a cancelled range never leaves a partial cache.
+    class CacheWriter
+    {
+    public:
+        CacheWriter() = default;
+
+        ~CacheWriter();
+
+        bool Open(const std::filesystem::path& file, const CacheHeader& header);
+
+        bool WriteTopology(const void* data, size_t size);
+
+        bool AppendFrame(int32_t time, const void* data, size_t size, uint32_t codec = CodecRaw, size_t rawSize = 0);
+
+        bool Close();
+
+        void Abort();
+
+        uint64_t Size() const noexcept;
+
+        CacheHeader& Header() noexcept;
+
+    private:
+        CacheWriter(const CacheWriter&) = delete;
+        CacheWriter& operator=(const CacheWriter&) = delete;
+
+        bool Pad();
+
+    private:
+        std::filesystem::path m_file;
+        std::filesystem::path m_temp;
+        std::ofstream m_stream;
+        CacheHeader m_header{};
+        std::vector<FrameRecord> m_frames;
+        uint64_t m_offset = 0;
+    };
+
+    // Random access to the frames of a .mxa file
+    class CacheReader
+    {
+    public:
+        CacheReader() = default;
+
+        bool Open(const std::filesystem::path& file);
+
+        void Close();
+
+        const CacheHeader& Header() const noexcept;
+
+        const std::vector<FrameRecord>& Frames() const noexcept;
+
+        size_t FrameAt(int32_t time) const noexcept;
+
+        bool ReadTopology(std::vector<unsigned char>& package);
+
+        bool ReadFrame(size_t index, std::vector<unsigned char>& data);
+
+    private:
+        CacheReader(const CacheReader&) = delete;
+        CacheReader& operator=(const CacheReader&) = delete;
+
+        bool Read(uint64_t offset, uint64_t size, std::vector<unsigned char>& data);
+
+    private:
+        std::ifstream m_stream;
+        CacheHeader m_header{};
+        std::vector<FrameRecord> m_frames;
+    };
+
+    // Frames of a .mxa file already in memory, e.g. a mapped view. Nothing is
+    // copied, pointers stay valid for as long as the memory does.
+    class CacheView
+    {
+    public:
+        CacheView() = default;
+
+        bool Open(const unsigned char* data, size_t size) noexcept;
+
+        const CacheHeader& Header() const noexcept;
+
+        size_t FrameCount() const noexcept;
+
+        const FrameRecord& Frame(size_t index) const noexcept;
+
+        const unsigned char* FrameData(size_t index) const noexcept;
+
+        size_t FrameAt(int32_t time) const noexcept;
+
+        const unsigned char* Topology() const noexcept;
+
+    private:
+        const unsigned char* m_data = nullptr;
+        size_t m_size = 0;
+        CacheHeader m_header{};
+        const FrameRecord* m_frames = nullptr;
+    };
+
+    constexpr uint32_t CacheMagic = 0x414D584D;    // "MXMA"
+    constexpr uint32_t CacheVersion = 2;
+    constexpr uint64_t FrameAlignment = 64;        // Frame streams start on cache line boundaries
+
+    inline size_t FindFrame(const FrameRecord* frames, size_t count, int32_t time) noexcept
+    {
+        auto after = std::upper_bound(frames, frames + count, time, [](int32_t t, const FrameRecord& frame) { return t < frame.time; });
+        return after == frames ? 0 : (size_t)(after - frames) - 1;
+    }
+
+    inline CacheWriter::~CacheWriter()
+    {
+        if (m_stream.is_open()) Abort();
+    }
+
+    inline bool CacheWriter::Open(const std::filesystem::path& file, const CacheHeader& header)
+    {
+        m_file = file;
+        m_temp = file;
+        m_temp += ".tmp";
+        m_header = header;
+        m_header.magic = CacheMagic;
+        m_header.version = CacheVersion;
+        m_frames.clear();
+
+        // Header Is Rewritten Once The Table Is Known
+        m_stream.open(m_temp, std::ios::binary | std::ios::trunc);
+        m_stream.write((const char*)&m_header, sizeof(CacheHeader));
+        m_offset = sizeof(CacheHeader);
+        return Pad();
+    }
+
+    inline bool CacheWriter::WriteTopology(const void* data, size_t size)
+    {
+        m_header.topologyOffset = m_offset;
+        m_header.topologySize = size;
+        m_stream.write((const char*)data, size);
+        m_offset += size;
+        return Pad();
+    }
+
+    inline bool CacheWriter::AppendFrame(int32_t time, const void* data, size_t size, uint32_t codec, size_t rawSize)
+    {
+        m_frames.push_back(FrameRecord{ time, codec, m_offset, size, rawSize ? rawSize : size });
+        m_stream.write((const char*)data, size);
+        m_offset += size;
+        return Pad();
+    }
+
+    inline bool CacheWriter::Close()
+    {
+        m_header.frameCount = (uint32_t)m_frames.size();
+        m_header.frameTableOffset = m_offset;
+        m_stream.write((const char*)m_frames.data(), m_frames.size() * sizeof(FrameRecord));
+        m_offset += m_frames.size() * sizeof(FrameRecord);
+        m_stream.seekp(0);
+        m_stream.write((const char*)&m_header, sizeof(CacheHeader));
+        bool written = (bool)m_stream.flush();
+        m_stream.close();
+
+        std::error_code error;
+        if (written) std::filesystem::rename(m_temp, m_file, error);
+        if (!written || error) { std::filesystem::remove(m_temp, error); return false; }
+        return true;
+    }
+
+    inline void CacheWriter::Abort()
+    {
+        m_stream.close();
+        std::error_code error;
+        std::filesystem::remove(m_temp, error);
+        m_frames.clear();
+    }
+
+    inline uint64_t CacheWriter::Size() const noexcept
+    {
+        return m_offset;
+    }
+
+    inline CacheHeader& CacheWriter::Header() noexcept
+    {
+        return m_header;
+    }
+
+    inline bool CacheWriter::Pad()
+    {
+        static const char zeros[FrameAlignment] = {};
+        uint64_t padding = (FrameAlignment - m_offset % FrameAlignment) % FrameAlignment;
+        m_stream.write(zeros, padding);
+        m_offset += padding;
+        return (bool)m_stream;
+    }
+
+    inline bool CacheReader::Open(const std::filesystem::path& file)
+    {
+        Close();
+        m_stream.open(file, std::ios::binary);
+        if (!m_stream.read((char*)&m_header, sizeof(CacheHeader))) return false;
+        if (m_header.magic != CacheMagic || m_header.version > CacheVersion) return false;
+
+        m_frames.resize(m_header.frameCount);
+        m_stream.seekg(m_header.frameTableOffset);
+        return (bool)m_stream.read((char*)m_frames.data(), m_frames.size() * sizeof(FrameRecord));
+    }
+
+    inline void CacheReader::Close()
+    {
+        if (m_stream.is_open()) m_stream.close();
+        m_stream.clear();
+        m_header = CacheHeader{};
+        m_frames.clear();
+    }
+
+    inline const CacheHeader& CacheReader::Header() const noexcept
+    {
+        return m_header;
+    }
+
+    inline const std::vector<FrameRecord>& CacheReader::Frames() const noexcept
+    {
+        return m_frames;
+    }
+
+    inline size_t CacheReader::FrameAt(int32_t time) const noexcept
+    {
+        return FindFrame(m_frames.data(), m_frames.size(), time);
+    }
+
+    inline bool CacheReader::ReadTopology(std::vector<unsigned char>& package)
+    {
+        return Read(m_header.topologyOffset, m_header.topologySize, package);
+    }
+
+    inline bool CacheReader::ReadFrame(size_t index, std::vector<unsigned char>& data)
+    {
+        if (index >= m_frames.size()) return false;
+        return Read(m_frames[index].offset, m_frames[index].size, data);
+    }
+
+    inline bool CacheReader::Read(uint64_t offset, uint64_t size, std::vector<unsigned char>& data)
+    {
+        data.resize((size_t)size);
+        m_stream.clear();
+        m_stream.seekg(offset);
+        return (bool)m_stream.read((char*)data.data(), size);
+    }
+
+    inline bool CacheView::Open(const unsigned char* data, size_t size) noexcept
+    {
+        m_data = nullptr;
+        m_frames = nullptr;
+        if (!data || size < sizeof(CacheHeader)) return false;
+
+        memcpy(&m_header, data, sizeof(CacheHeader));
+        if (m_header.magic != CacheMagic || m_header.version > CacheVersion) return false;
+        if (m_header.frameTableOffset + (uint64_t)m_header.frameCount * sizeof(FrameRecord) > size) return false;
+        if (m_header.topologyOffset + m_header.topologySize > size) return false;
+
+        // Every Frame Must Lie Inside The File
+        const FrameRecord* frames = (const FrameRecord*)(data + m_header.frameTableOffset);
+        for (size_t i = 0; i < m_header.frameCount; i++)
+            if (frames[i].offset + frames[i].size > size) return false;
+
+        m_data = data;
+        m_size = size;
+        m_frames = frames;
+        return true;
+    }
+
+    inline const CacheHeader& CacheView::Header() const noexcept
+    {
+        return m_header;
+    }
+
+    inline size_t CacheView::FrameCount() const noexcept
+    {
+        return m_frames ? m_header.frameCount : 0;
+    }
+
+    inline const FrameRecord& CacheView::Frame(size_t index) const noexcept
+    {
+        return m_frames[index];
+    }
+
+    inline const unsigned char* CacheView::FrameData(size_t index) const noexcept
+    {
+        return m_data + m_frames[index].offset;
+    }
+
+    inline size_t CacheView::FrameAt(int32_t time) const noexcept
+    {
+        return FindFrame(m_frames, FrameCount(), time);
+    }
+
+    inline const unsigned char* CacheView::Topology() const noexcept
+    {
+        return m_data + m_header.topologyOffset;
+    }
+}
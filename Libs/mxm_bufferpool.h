@@ -0,0 +1,173 @@
+////////////////  Developed By Hamid.Memar (2023-Revised)  ////////////////
+///////////////   Licensed Under MIT Terms And Arguments   ////////////////
+
+#pragma once
+
+#include <mutex>
+#include <vector>
+#include <cstdint>
+
+namespace BufferPools
+{
+    // Counters since the last ResetStats(), sizes in bytes
+    struct PoolStats
+    {
+        uint64_t hits;              // Acquires served from a retained buffer
+        uint64_t misses;            // Acquires that had to allocate
+        uint64_t releases;          // Buffers handed back to the pool
+        uint64_t evictions;         // Released buffers dropped to honour the retention limit
+        size_t retainedBytes;       // Capacity currently parked in the pool
+        size_t peakRetainedBytes;
+        size_t retentionLimit;
+    };
+
+    // Thread-safe pool of byte vectors, bucketed by power-of-two capacity.
+    // Acquired buffers are empty but keep their capacity, so filling them
+    // up to the requested size does not touch the allocator.
+    class BufferPool
+    {
+    public:
+        using Buffer = std::vector<unsigned char>;
+
+        explicit BufferPool(size_t retentionLimit) noexcept;
+
+        Buffer Acquire(size_t size);
+
+        void Release(Buffer& buffer);
+
+        void SetRetentionLimit(size_t retentionLimit);
+
+        size_t RetentionLimit() const;
+
+        void Trim();
+
+        PoolStats Stats() const;
+
+        void ResetStats();
+
+    private:
+        BufferPool(const BufferPool&) = delete;
+        BufferPool& operator=(const BufferPool&) = delete;
+
+        static size_t SizeClass(size_t size) noexcept;
+
+        void EvictUntil(size_t retainedBytes);
+
+    private:
+        static constexpr size_t ClassCount = 48;
+        static constexpr size_t ClassReach = 2;     // Oversized classes searched before allocating
+
+        mutable std::mutex m_lock;
+        std::vector<Buffer> m_classes[ClassCount];
+        PoolStats m_stats;
+    };
+
+    inline BufferPool::BufferPool(size_t retentionLimit) noexcept
+        : m_stats{}
+    {
+        m_stats.retentionLimit = retentionLimit;
+    }
+
+    inline size_t BufferPool::SizeClass(size_t size) noexcept
+    {
+        size_t sizeClass = 0;
+        while (size > 1 && sizeClass < ClassCount - 1) { size >>= 1; sizeClass++; }
+        return sizeClass;
+    }
+
+    inline BufferPool::Buffer BufferPool::Acquire(size_t size)
+    {
+        if (size)
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            size_t first = SizeClass(size);
+            size_t last = first + ClassReach < ClassCount ? first + ClassReach : ClassCount - 1;
+            for (size_t c = first; c <= last; c++)
+            {
+                auto& bucket = m_classes[c];
+                for (size_t i = bucket.size(); i-- > 0;)
+                {
+                    if (bucket[i].capacity() < size) continue;
+                    Buffer buffer = std::move(bucket[i]);
+                    bucket.erase(bucket.begin() + i);
+                    m_stats.retainedBytes -= buffer.capacity();
+                    m_stats.hits++;
+                    return buffer;
+                }
+            }
+            m_stats.misses++;
+        }
+
+        Buffer buffer;
+        buffer.reserve(size);
+        return buffer;
+    }
+
+    inline void BufferPool::Release(Buffer& buffer)
+    {
+        size_t capacity = buffer.capacity();
+        if (capacity == 0) return;
+
+        Buffer parked = std::move(buffer);
+        buffer = Buffer();
+        parked.clear();
+
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_stats.releases++;
+        if (capacity > m_stats.retentionLimit) { m_stats.evictions++; return; }
+
+        // Make Room For The Incoming Buffer
+        EvictUntil(m_stats.retentionLimit - capacity);
+        m_classes[SizeClass(capacity)].push_back(std::move(parked));
+        m_stats.retainedBytes += capacity;
+        if (m_stats.retainedBytes > m_stats.peakRetainedBytes) m_stats.peakRetainedBytes = m_stats.retainedBytes;
+    }
+
+    inline void BufferPool::EvictUntil(size_t retainedBytes)
+    {
+        // Largest Classes First, They Free The Most With The Fewest Drops
+        for (size_t c = ClassCount; c-- > 0 && m_stats.retainedBytes > retainedBytes;)
+        {
+            auto& bucket = m_classes[c];
+            while (!bucket.empty() && m_stats.retainedBytes > retainedBytes)
+            {
+                m_stats.retainedBytes -= bucket.front().capacity();
+                bucket.erase(bucket.begin());
+                m_stats.evictions++;
+            }
+        }
+    }
+
+    inline void BufferPool::SetRetentionLimit(size_t retentionLimit)
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_stats.retentionLimit = retentionLimit;
+        EvictUntil(retentionLimit);
+    }
+
+    inline size_t BufferPool::RetentionLimit() const
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        return m_stats.retentionLimit;
+    }
+
+    inline void BufferPool::Trim()
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        for (auto& bucket : m_classes) std::vector<Buffer>().swap(bucket);
+        m_stats.retainedBytes = 0;
+    }
+
+    inline PoolStats BufferPool::Stats() const
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        return m_stats;
+    }
+
+    inline void BufferPool::ResetStats()
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_stats.hits = m_stats.misses = m_stats.releases = m_stats.evictions = 0;
+        m_stats.peakRetainedBytes = m_stats.retainedBytes;
+    }
+}
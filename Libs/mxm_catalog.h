@@ -0,0 +1,286 @@
+////////////////  Developed By Hamid.Memar (2023-Revised)  ////////////////
+///////////////   Licensed Under MIT Terms And Arguments   ////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Catalogs
+{
+    // One package, fixed size so the whole catalog loads with a single read
+    struct CatalogRecord
+    {
+        char file[260];             // Package file name inside the catalog folder, lower case
+        char node[128];             // Source node name
+        int64_t timestamp;          // Write time, seconds since epoch
+        int32_t vNum;
+        int32_t fNum;
+        float bboxMin[3];
+        float bboxMax[3];
+        uint64_t packageSize;       // Compressed bytes on disk
+        uint64_t rawSize;           // Uncompressed channel bytes
+        uint64_t fingerprint;       // Topology hash, 0 when unknown
+        int64_t lastAccess;         // Last cache or restore, seconds since epoch, 0 when never restored
+        uint32_t flags;
+        uint32_t reserved;
+    };
+
+    // Record flags
+    constexpr uint32_t RecordPinned = 0x1;      // Never evicted by quota sweeps
+
+    // Folder limits, 0 means unlimited
+    struct CatalogQuota
+    {
+        uint64_t bytes;
+        uint32_t count;
+        uint32_t reserved;
+    };
+
+    // Case-insensitive match supporting '*' and '?'
+    bool MatchWildcard(const char* pattern, const char* text) noexcept;
+
+    // Index of the packages in one folder, persisted next to them.
+    // Saving goes through a temporary file and a rename, so readers
+    // never observe a half-written catalog.
+    class Catalog
+    {
+    public:
+        Catalog() = default;
+
+        bool Load(const std::filesystem::path& file);
+
+        bool Save() const;
+
+        void Clear();
+
+        void Upsert(const CatalogRecord& record);
+
+        bool Remove(const char* file);
+
+        const CatalogRecord* Find(const char* file) const;
+
+        CatalogRecord* Find(const char* file);
+
+        std::vector<const CatalogRecord*> List(const char* filter) const;
+
+        const std::vector<CatalogRecord>& Records() const noexcept;
+
+        uint64_t TotalSize() const noexcept;
+
+        std::vector<std::string> EvictionOrder() const;
+
+        const CatalogQuota& Quota() const noexcept;
+
+        void SetQuota(const CatalogQuota& quota) noexcept;
+
+        const std::filesystem::path& File() const noexcept;
+
+        void SetFile(const std::filesystem::path& file);
+
+    private:
+        struct Header
+        {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t recordSize;
+            uint32_t count;
+            CatalogQuota quota;         // Version 2 and later
+        };
+
+        static constexpr uint32_t Magic = 0x434D584D;    // "MXMC"
+        static constexpr uint32_t Version = 2;
+        static constexpr size_t LegacyHeaderSize = offsetof(Header, quota);
+
+        void Reindex();
+
+    private:
+        std::filesystem::path m_file;
+        std::vector<CatalogRecord> m_records;
+        std::unordered_map<std::string, size_t> m_index;
+        CatalogQuota m_quota{};
+    };
+
+    inline bool MatchWildcard(const char* pattern, const char* text) noexcept
+    {
+        const char* star = nullptr;
+        const char* resume = nullptr;
+        while (*text)
+        {
+            if (*pattern == '*') { star = pattern++; resume = text; continue; }
+            if (*pattern == '?' || ::tolower((unsigned char)*pattern) == ::tolower((unsigned char)*text)) { pattern++; text++; continue; }
+            if (!star) return false;
+            pattern = star + 1;
+            text = ++resume;
+        }
+        while (*pattern == '*') pattern++;
+        return *pattern == 0;
+    }
+
+    inline bool Catalog::Load(const std::filesystem::path& file)
+    {
+        Clear();
+        m_file = file;
+
+        std::ifstream stream(file, std::ios::binary);
+        Header header{};
+        if (!stream.read((char*)&header, LegacyHeaderSize)) return false;
+        if (header.magic != Magic || header.recordSize == 0) return false;
+        if (header.version >= 2 && !stream.read((char*)&header.quota, sizeof(CatalogQuota))) return false;
+        m_quota = header.quota;
+
+        // Older Records Are Zero Extended, Newer Ones Truncated
+        std::vector<char> raw((size_t)header.recordSize * header.count);
+        if (!stream.read(raw.data(), raw.size())) return false;
+
+        m_records.resize(header.count);
+        size_t copy = std::min<size_t>(header.recordSize, sizeof(CatalogRecord));
+        for (size_t i = 0; i < header.count; i++)
+        {
+            memset(&m_records[i], 0, sizeof(CatalogRecord));
+            memcpy(&m_records[i], raw.data() + i * header.recordSize, copy);
+            m_records[i].file[sizeof(m_records[i].file) - 1] = 0;
+            m_records[i].node[sizeof(m_records[i].node) - 1] = 0;
+        }
+        Reindex();
+        return true;
+    }
+
+    inline bool Catalog::Save() const
+    {
+        std::filesystem::path temp = m_file;
+        temp += ".tmp";
+
+        {
+            std::ofstream stream(temp, std::ios::binary | std::ios::trunc);
+            Header header{ Magic, Version, (uint32_t)sizeof(CatalogRecord), (uint32_t)m_records.size(), m_quota };
+            stream.write((const char*)&header, sizeof(Header));
+            stream.write((const char*)m_records.data(), m_records.size() * sizeof(CatalogRecord));
+            if (!stream.flush()) return false;
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temp, m_file, error);
+        if (error) std::filesystem::remove(temp, error);
+        return !error;
+    }
+
+    inline void Catalog::Clear()
+    {
+        m_quota = CatalogQuota{};
+        m_records.clear();
+        m_index.clear();
+    }
+
+    inline void Catalog::Upsert(const CatalogRecord& record)
+    {
+        auto found = m_index.find(record.file);
+        if (found != m_index.end()) { m_records[found->second] = record; return; }
+        m_index.emplace(record.file, m_records.size());
+        m_records.push_back(record);
+    }
+
+    inline bool Catalog::Remove(const char* file)
+    {
+        auto found = m_index.find(file);
+        if (found == m_index.end()) return false;
+
+        // Swap With Last, Order Is Not Significant
+        size_t slot = found->second;
+        m_index.erase(found);
+        if (slot != m_records.size() - 1)
+        {
+            m_records[slot] = m_records.back();
+            m_index[m_records[slot].file] = slot;
+        }
+        m_records.pop_back();
+        return true;
+    }
+
+    inline const CatalogRecord* Catalog::Find(const char* file) const
+    {
+        auto found = m_index.find(file);
+        return found == m_index.end() ? nullptr : &m_records[found->second];
+    }
+
+    inline CatalogRecord* Catalog::Find(const char* file)
+    {
+        auto found = m_index.find(file);
+        return found == m_index.end() ? nullptr : &m_records[found->second];
+    }
+
+    inline std::vector<const CatalogRecord*> Catalog::List(const char* filter) const
+    {
+        std::vector<const CatalogRecord*> listed;
+        listed.reserve(m_records.size());
+        for (auto& record : m_records)
+            if (!filter || !*filter || MatchWildcard(filter, record.file) || MatchWildcard(filter, record.node))
+                listed.push_back(&record);
+
+        std::sort(listed.begin(), listed.end(), [](const CatalogRecord* a, const CatalogRecord* b) { return strcmp(a->file, b->file) < 0; });
+        return listed;
+    }
+
+    inline const std::vector<CatalogRecord>& Catalog::Records() const noexcept
+    {
+        return m_records;
+    }
+
+    inline uint64_t Catalog::TotalSize() const noexcept
+    {
+        uint64_t total = 0;
+        for (auto& record : m_records) total += record.packageSize;
+        return total;
+    }
+
+    inline std::vector<std::string> Catalog::EvictionOrder() const
+    {
+        // Unpinned Packages, Least Recently Used First
+        std::vector<const CatalogRecord*> candidates;
+        for (auto& record : m_records)
+            if (!(record.flags & RecordPinned)) candidates.push_back(&record);
+
+        auto used = [](const CatalogRecord* record) { return record->lastAccess ? record->lastAccess : record->timestamp; };
+        std::sort(candidates.begin(), candidates.end(), [&](const CatalogRecord* a, const CatalogRecord* b) { return used(a) < used(b); });
+
+        std::vector<std::string> order;
+        order.reserve(candidates.size());
+        for (auto record : candidates) order.push_back(record->file);
+        return order;
+    }
+
+    inline const CatalogQuota& Catalog::Quota() const noexcept
+    {
+        return m_quota;
+    }
+
+    inline void Catalog::SetQuota(const CatalogQuota& quota) noexcept
+    {
+        m_quota = quota;
+    }
+
+    inline const std::filesystem::path& Catalog::File() const noexcept
+    {
+        return m_file;
+    }
+
+    inline void Catalog::SetFile(const std::filesystem::path& file)
+    {
+        m_file = file;
+    }
+
+    inline void Catalog::Reindex()
+    {
+        m_index.clear();
+        m_index.reserve(m_records.size());
+        for (size_t i = 0; i < m_records.size(); i++) m_index.emplace(m_records[i].file, i);
+    }
+}
@@ -0,0 +1,168 @@
+////////////////  Developed By Hamid.Memar (2023-Revised)  ////////////////
+///////////////   Licensed Under MIT Terms And Arguments   ////////////////
+
+#pragma once
+
+#include <Windows.h>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace SharedClipboards
+{
+    // Clipboard shared by every process of the session through named memory.
+    // A small fixed header segment announces the latest generation, the bytes
+    // live in a segment named after that generation. The publisher keeps its
+    // segment open, so the data stays readable until it publishes again or exits.
+    class SharedClipboard
+    {
+    public:
+        explicit SharedClipboard(const wchar_t* name);
+
+        ~SharedClipboard();
+
+        bool Publish(const void* data, size_t size, uint64_t& generation);
+
+        uint64_t Generation();
+
+        bool Fetch(std::vector<unsigned char>& data, uint64_t& generation);
+
+    private:
+        SharedClipboard(const SharedClipboard&) = delete;
+        SharedClipboard& operator=(const SharedClipboard&) = delete;
+
+        struct Header
+        {
+            uint32_t magic;
+            uint32_t version;
+            uint64_t generation;        // 0 until the first publish
+            uint64_t size;
+            uint32_t ownerProcess;
+            uint32_t reserved;
+        };
+
+        static constexpr uint32_t Magic = 0x424D584D;    // "MXMB"
+        static constexpr uint32_t Version = 1;
+
+        bool Open();
+
+        bool Lock();
+
+        void Unlock();
+
+        std::wstring SegmentName(uint64_t generation) const;
+
+    private:
+        std::wstring m_name;
+        HANDLE m_mutex = nullptr;
+        HANDLE m_header = nullptr;
+        Header* m_view = nullptr;
+        HANDLE m_segment = nullptr;     // Last segment this process published
+    };
+
+    inline SharedClipboard::SharedClipboard(const wchar_t* name)
+        : m_name{ name }
+    {}
+
+    inline SharedClipboard::~SharedClipboard()
+    {
+        if (m_view) UnmapViewOfFile(m_view);
+        if (m_header) CloseHandle(m_header);
+        if (m_segment) CloseHandle(m_segment);
+        if (m_mutex) CloseHandle(m_mutex);
+    }
+
+    inline bool SharedClipboard::Open()
+    {
+        if (m_view) return true;
+
+        // Zero Filled On Creation, So A Fresh Header Reads As Generation 0
+        if (!m_mutex) m_mutex = CreateMutexW(nullptr, FALSE, (m_name + L".Lock").c_str());
+        if (!m_mutex) return false;
+        if (!m_header) m_header = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, sizeof(Header), m_name.c_str());
+        if (!m_header) return false;
+        m_view = (Header*)MapViewOfFile(m_header, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(Header));
+        return m_view != nullptr;
+    }
+
+    inline bool SharedClipboard::Lock()
+    {
+        if (!Open()) return false;
+        DWORD result = WaitForSingleObject(m_mutex, INFINITE);
+        return result == WAIT_OBJECT_0 || result == WAIT_ABANDONED;
+    }
+
+    inline void SharedClipboard::Unlock()
+    {
+        ReleaseMutex(m_mutex);
+    }
+
+    inline std::wstring SharedClipboard::SegmentName(uint64_t generation) const
+    {
+        return m_name + L"." + std::to_wstring(generation);
+    }
+
+    inline bool SharedClipboard::Publish(const void* data, size_t size, uint64_t& generation)
+    {
+        if (!Lock()) return false;
+
+        uint64_t next = (m_view->magic == Magic ? m_view->generation : 0) + 1;
+        uint64_t mapped = (uint64_t)size ? (uint64_t)size : 1;
+        HANDLE segment = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+            (DWORD)(mapped >> 32), (DWORD)(mapped & 0xFFFFFFFF), SegmentName(next).c_str());
+        void* view = segment ? MapViewOfFile(segment, FILE_MAP_WRITE, 0, 0, size) : nullptr;
+        if (!view)
+        {
+            if (segment) CloseHandle(segment);
+            Unlock();
+            return false;
+        }
+        memcpy(view, data, size);
+        UnmapViewOfFile(view);
+
+        // Previous Segment Goes Away Once No Reader Holds It
+        if (m_segment) CloseHandle(m_segment);
+        m_segment = segment;
+
+        m_view->magic = Magic;
+        m_view->version = Version;
+        m_view->generation = next;
+        m_view->size = size;
+        m_view->ownerProcess = GetCurrentProcessId();
+        generation = next;
+
+        Unlock();
+        return true;
+    }
+
+    inline uint64_t SharedClipboard::Generation()
+    {
+        if (!Lock()) return 0;
+        uint64_t generation = m_view->magic == Magic ? m_view->generation : 0;
+        Unlock();
+        return generation;
+    }
+
+    inline bool SharedClipboard::Fetch(std::vector<unsigned char>& data, uint64_t& generation)
+    {
+        if (!Lock()) return false;
+        if (m_view->magic != Magic || m_view->version != Version || m_view->generation == 0) { Unlock(); return false; }
+
+        // The Publisher May Have Exited, Taking Its Segment With It
+        Header header = *m_view;
+        HANDLE segment = OpenFileMappingW(FILE_MAP_READ, FALSE, SegmentName(header.generation).c_str());
+        const void* view = segment ? MapViewOfFile(segment, FILE_MAP_READ, 0, 0, (SIZE_T)header.size) : nullptr;
+        if (view)
+        {
+            data.resize((size_t)header.size);
+            memcpy(data.data(), view, data.size());
+            UnmapViewOfFile(view);
+            generation = header.generation;
+        }
+        if (segment) CloseHandle(segment);
+
+        Unlock();
+        return view != nullptr;
+    }
+}
@@ -0,0 +1,195 @@
+////////////////  Developed By Hamid.Memar (2023-Revised)  ////////////////
+///////////////   Licensed Under MIT Terms And Arguments   ////////////////
+
+#pragma once
+
+#include <ppl.h>
+#include <chrono>
+#include <cstring>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define COPY_KERNELS_SSE2
+#endif
+
+namespace CopyKernels
+{
+    // Tunables picked by Calibrate(), persisted by the caller
+    struct Calibration
+    {
+        size_t grainSize;           // Bytes copied by one parallel task
+        size_t parallelThreshold;   // Smallest copy worth splitting across threads
+        size_t streamThreshold;     // Smallest copy that bypasses the cache with non-temporal stores
+    };
+
+    // One microbenchmark row, throughput in MB/s
+    struct Sample
+    {
+        size_t size;
+        double memcpyMBps;
+        double parallelMBps;
+        double streamMBps;
+    };
+
+    constexpr Calibration DefaultCalibration{ 1u << 20, 8u << 20, 64u << 20 };
+
+    size_t BalancedGrain(size_t count, size_t tasksPerThread = 4) noexcept;
+
+    template<typename RangeBody> void ParallelRanges(size_t count, size_t grain, const RangeBody& body);
+
+    template<typename Body> void ParallelChunks(size_t count, size_t grain, const Body& body);
+
+    void StreamCopy(void* dst, const void* src, size_t size) noexcept;
+
+    void ParallelCopy(void* dst, const void* src, size_t size, const Calibration& calibration);
+
+    Calibration Calibrate(std::vector<Sample>& samples, size_t maxSize = 128u << 20);
+
+    inline size_t BalancedGrain(size_t count, size_t tasksPerThread) noexcept
+    {
+        size_t threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+        size_t tasks = threads * tasksPerThread;
+        return std::max<size_t>(1, (count + tasks - 1) / tasks);
+    }
+
+    template<typename RangeBody> inline void ParallelRanges(size_t count, size_t grain, const RangeBody& body)
+    {
+        grain = std::max<size_t>(1, grain);
+        size_t chunks = (count + grain - 1) / grain;
+        concurrency::parallel_for(size_t(0), chunks, [&](size_t chunk)
+        {
+            body(chunk * grain, std::min<size_t>(count, (chunk + 1) * grain));
+        });
+    }
+
+    template<typename Body> inline void ParallelChunks(size_t count, size_t grain, const Body& body)
+    {
+        ParallelRanges(count, grain, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++) body(i);
+        });
+    }
+
+    inline void StreamCopy(void* dst, const void* src, size_t size) noexcept
+    {
+#ifdef COPY_KERNELS_SSE2
+        char* d = static_cast<char*>(dst);
+        const char* s = static_cast<const char*>(src);
+
+        // Align Destination To 16 Bytes
+        size_t head = (16 - (reinterpret_cast<uintptr_t>(d) & 15)) & 15;
+        if (head > size) head = size;
+        memcpy(d, s, head);
+        d += head; s += head; size -= head;
+
+        // Non-Temporal Body, 64 Bytes Per Iteration
+        size_t blocks = size / 64;
+        for (size_t i = 0; i < blocks; i++, d += 64, s += 64)
+        {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16));
+            __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 32));
+            __m128i e = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 48));
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d), a);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d + 16), b);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d + 32), c);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d + 48), e);
+        }
+        _mm_sfence();
+
+        // Tail
+        memcpy(d, s, size - blocks * 64);
+#else
+        memcpy(dst, src, size);
+#endif
+    }
+
+    inline void ParallelCopy(void* dst, const void* src, size_t size, const Calibration& calibration)
+    {
+        bool stream = size >= calibration.streamThreshold;
+        size_t grain = std::max<size_t>(64 * 1024, calibration.grainSize & ~size_t(63));
+
+        if (size < grain * 2)
+        {
+            if (stream) StreamCopy(dst, src, size);
+            else memcpy(dst, src, size);
+            return;
+        }
+
+        char* d = static_cast<char*>(dst);
+        const char* s = static_cast<const char*>(src);
+        size_t chunks = (size + grain - 1) / grain;
+        concurrency::parallel_for(size_t(0), chunks, [&](size_t chunk)
+        {
+            size_t offset = chunk * grain;
+            size_t bytes = std::min<size_t>(grain, size - offset);
+            if (stream) StreamCopy(d + offset, s + offset, bytes);
+            else memcpy(d + offset, s + offset, bytes);
+        });
+    }
+
+    inline Calibration Calibrate(std::vector<Sample>& samples, size_t maxSize)
+    {
+        using clock = std::chrono::steady_clock;
+        Calibration calibration = DefaultCalibration;
+        samples.clear();
+
+        // Touch Every Page Up Front So Page Faults Stay Out Of The Timings
+        std::vector<char> source(maxSize, 1), target(maxSize, 0);
+
+        auto measure = [&](size_t size, auto&& copy)
+        {
+            // Best Of Several Repetitions, At Least 256 MB Moved Per Measurement
+            size_t reps = std::max<size_t>(3, (256u << 20) / size);
+            double best = 1e30;
+            for (int round = 0; round < 3; round++)
+            {
+                auto start = clock::now();
+                for (size_t r = 0; r < reps; r++) copy(target.data(), source.data(), size);
+                double seconds = std::chrono::duration<double>(clock::now() - start).count() / reps;
+                best = std::min<double>(best, seconds);
+            }
+            return (size / (1024.0 * 1024.0)) / std::max<double>(best, 1e-9);
+        };
+
+        // Grain, Tuned On The Largest Copy
+        double bestGrainMBps = 0;
+        for (size_t grain : { size_t(256u << 10), size_t(1u << 20), size_t(4u << 20) })
+        {
+            Calibration candidate{ grain, 0, SIZE_MAX };
+            double mbps = measure(maxSize, [&](void* d, const void* s, size_t n) { ParallelCopy(d, s, n, candidate); });
+            if (mbps > bestGrainMBps) { bestGrainMBps = mbps; calibration.grainSize = grain; }
+        }
+
+        // Thresholds, Smallest Size From Which The Faster Kernel Keeps Winning
+        calibration.parallelThreshold = SIZE_MAX;
+        calibration.streamThreshold = SIZE_MAX;
+        // Steps Of Four, The Last One Clamped So maxSize Itself Is Always Measured
+        for (size_t size = std::min<size_t>(64u << 10, maxSize); ; size = std::min(size * 4, maxSize))
+        {
+            Calibration cached{ calibration.grainSize, 0, SIZE_MAX };
+            Calibration streamed{ calibration.grainSize, 0, 0 };
+
+            Sample sample;
+            sample.size = size;
+            sample.memcpyMBps = measure(size, [](void* d, const void* s, size_t n) { memcpy(d, s, n); });
+            sample.parallelMBps = measure(size, [&](void* d, const void* s, size_t n) { ParallelCopy(d, s, n, cached); });
+            sample.streamMBps = measure(size, [&](void* d, const void* s, size_t n) { ParallelCopy(d, s, n, streamed); });
+            samples.push_back(sample);
+
+            bool parallelWins = sample.parallelMBps > sample.memcpyMBps * 1.1;
+            bool streamWins = sample.streamMBps > sample.parallelMBps * 1.05;
+            if (parallelWins && calibration.parallelThreshold == SIZE_MAX) calibration.parallelThreshold = size;
+            if (!parallelWins) calibration.parallelThreshold = SIZE_MAX;
+            if (streamWins && calibration.streamThreshold == SIZE_MAX) calibration.streamThreshold = size;
+            if (!streamWins) calibration.streamThreshold = SIZE_MAX;
+            if (size == maxSize) break;
+        }
+
+        return calibration;
+    }
+}
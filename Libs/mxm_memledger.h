@@ -0,0 +1,323 @@
+////////////////  Developed By Hamid.Memar (2023-Revised)  ////////////////
+///////////////   Licensed Under MIT Terms And Arguments   ////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace MemoryLedgers
+{
+    // What the bytes were allocated for
+    enum Category : int
+    {
+        LedgerStaging,              // Inflated channel buffers
+        LedgerMeshes,               // Decoded and intermediate meshes
+        LedgerUndo,                 // Undo records kept by the hold
+        CategoryCount
+    };
+
+    const char* CategoryName(Category category) noexcept;
+
+    // Sizes in bytes, operation figures are relative to the start of the operation
+    // in flight, or of the last one once it ended
+    struct CategoryUsage
+    {
+        uint64_t current;
+        uint64_t peak;
+        uint64_t operationCurrent;
+        uint64_t operationPeak;
+    };
+
+    struct LedgerStats
+    {
+        CategoryUsage categories[CategoryCount];
+        uint64_t current;
+        uint64_t peak;
+        uint64_t operationCurrent;
+        uint64_t operationPeak;
+        uint64_t operationLimit;    // 0 means unlimited
+        uint64_t refused;           // Charges turned down by the operation limit
+    };
+
+    // Bytes the plugin holds, charged by the owner of each allocation.
+    // Inside an operation a charge that would take the bytes added since
+    // the operation began past the limit is refused and nothing is recorded,
+    // so callers can fail before allocating instead of running out of memory.
+    // Only the thread that began the operation counts toward its figures and
+    // limit, background work shows up in the totals alone.
+    class MemoryLedger
+    {
+    public:
+        MemoryLedger() = default;
+
+        bool Charge(Category category, uint64_t bytes);
+
+        void Credit(Category category, uint64_t bytes);
+
+        void BeginOperation();
+
+        LedgerStats EndOperation();
+
+        void SetOperationLimit(uint64_t bytes);
+
+        uint64_t OperationLimit() const;
+
+        // Nested, while any suspension is held charges are recorded but never refused
+        void SuspendLimit();
+
+        void ResumeLimit();
+
+        LedgerStats Stats() const;
+
+        void ResetPeaks();
+
+    private:
+        MemoryLedger(const MemoryLedger&) = delete;
+        MemoryLedger& operator=(const MemoryLedger&) = delete;
+
+        uint64_t OperationBytes(int category) const noexcept;
+
+        uint64_t OperationTotal() const noexcept;
+
+        LedgerStats Snapshot() const noexcept;
+
+    private:
+        mutable std::mutex m_lock;
+        uint64_t m_current[CategoryCount] = {};
+        uint64_t m_peak[CategoryCount] = {};
+        int64_t m_operationNet[CategoryCount] = {};     // Charged minus credited by the owner
+        uint64_t m_operationPeak[CategoryCount] = {};
+        uint64_t m_totalPeak = 0;
+        uint64_t m_operationTotalPeak = 0;
+        uint64_t m_limit = 0;
+        uint64_t m_refused = 0;
+        int m_depth = 0;
+        int m_suspended = 0;
+        std::thread::id m_owner;
+    };
+
+    // Lifts the operation limit for the lifetime of the scope, for work that puts back
+    // memory the operation already gave up, e.g. undo restoring a replaced mesh
+    class ScopedLimitSuspension
+    {
+    public:
+        explicit ScopedLimitSuspension(MemoryLedger& ledger) noexcept;
+
+        ~ScopedLimitSuspension();
+
+    private:
+        ScopedLimitSuspension(const ScopedLimitSuspension&) = delete;
+        ScopedLimitSuspension& operator=(const ScopedLimitSuspension&) = delete;
+
+        MemoryLedger& m_ledger;
+    };
+
+    // Holds a charge for the lifetime of the scope, resizable as the allocation changes
+    class ScopedCharge
+    {
+    public:
+        ScopedCharge(MemoryLedger& ledger, Category category, uint64_t bytes = 0) noexcept;
+
+        ~ScopedCharge();
+
+        bool Resize(uint64_t bytes) noexcept;
+
+        bool Granted() const noexcept;
+
+        uint64_t Bytes() const noexcept;
+
+    private:
+        ScopedCharge(const ScopedCharge&) = delete;
+        ScopedCharge& operator=(const ScopedCharge&) = delete;
+
+        MemoryLedger& m_ledger;
+        Category m_category;
+        uint64_t m_bytes;
+        bool m_granted;
+    };
+
+    inline const char* CategoryName(Category category) noexcept
+    {
+        switch (category)
+        {
+        case LedgerStaging: return "staging";
+        case LedgerMeshes: return "mesh";
+        case LedgerUndo: return "undo";
+        default: return "unknown";
+        }
+    }
+
+    inline bool MemoryLedger::Charge(Category category, uint64_t bytes)
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        bool owned = m_depth > 0 && m_owner == std::this_thread::get_id();
+        if (owned && m_limit && !m_suspended && OperationTotal() + bytes > m_limit) { m_refused++; return false; }
+
+        m_current[category] += bytes;
+        m_peak[category] = std::max<uint64_t>(m_peak[category], m_current[category]);
+
+        uint64_t total = 0;
+        for (auto current : m_current) total += current;
+        m_totalPeak = std::max<uint64_t>(m_totalPeak, total);
+
+        if (owned)
+        {
+            m_operationNet[category] += (int64_t)bytes;
+            m_operationPeak[category] = std::max<uint64_t>(m_operationPeak[category], OperationBytes(category));
+            m_operationTotalPeak = std::max<uint64_t>(m_operationTotalPeak, OperationTotal());
+        }
+        return true;
+    }
+
+    inline void MemoryLedger::Credit(Category category, uint64_t bytes)
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_current[category] -= std::min<uint64_t>(bytes, m_current[category]);
+        if (m_depth > 0 && m_owner == std::this_thread::get_id()) m_operationNet[category] -= (int64_t)bytes;
+    }
+
+    inline void MemoryLedger::BeginOperation()
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (m_depth++ > 0) return;
+
+        m_owner = std::this_thread::get_id();
+        for (int c = 0; c < CategoryCount; c++)
+        {
+            m_operationNet[c] = 0;
+            m_operationPeak[c] = 0;
+        }
+        m_operationTotalPeak = 0;
+    }
+
+    inline LedgerStats MemoryLedger::EndOperation()
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (m_depth > 0 && --m_depth == 0) m_owner = std::thread::id();
+        return Snapshot();
+    }
+
+    inline void MemoryLedger::SetOperationLimit(uint64_t bytes)
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_limit = bytes;
+    }
+
+    inline uint64_t MemoryLedger::OperationLimit() const
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        return m_limit;
+    }
+
+    inline void MemoryLedger::SuspendLimit()
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_suspended++;
+    }
+
+    inline void MemoryLedger::ResumeLimit()
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (m_suspended > 0) m_suspended--;
+    }
+
+    inline LedgerStats MemoryLedger::Stats() const
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        return Snapshot();
+    }
+
+    inline void MemoryLedger::ResetPeaks()
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        uint64_t total = 0;
+        for (int c = 0; c < CategoryCount; c++)
+        {
+            m_peak[c] = m_current[c];
+            total += m_current[c];
+        }
+        m_totalPeak = total;
+        m_refused = 0;
+    }
+
+    inline uint64_t MemoryLedger::OperationBytes(int category) const noexcept
+    {
+        // Records Released During The Operation Never Make It Negative
+        return m_operationNet[category] > 0 ? (uint64_t)m_operationNet[category] : 0;
+    }
+
+    inline uint64_t MemoryLedger::OperationTotal() const noexcept
+    {
+        uint64_t total = 0;
+        for (int c = 0; c < CategoryCount; c++) total += OperationBytes(c);
+        return total;
+    }
+
+    inline LedgerStats MemoryLedger::Snapshot() const noexcept
+    {
+        LedgerStats stats{};
+        for (int c = 0; c < CategoryCount; c++)
+        {
+            stats.categories[c] = CategoryUsage{ m_current[c], m_peak[c], OperationBytes(c), m_operationPeak[c] };
+            stats.current += m_current[c];
+        }
+        stats.peak = m_totalPeak;
+        stats.operationCurrent = OperationTotal();
+        stats.operationPeak = m_operationTotalPeak;
+        stats.operationLimit = m_limit;
+        stats.refused = m_refused;
+        return stats;
+    }
+
+    inline ScopedCharge::ScopedCharge(MemoryLedger& ledger, Category category, uint64_t bytes) noexcept
+        : m_ledger{ ledger }
+        , m_category{ category }
+        , m_bytes{ 0 }
+        , m_granted{ true }
+    {
+        Resize(bytes);
+    }
+
+    inline ScopedCharge::~ScopedCharge()
+    {
+        m_ledger.Credit(m_category, m_bytes);
+    }
+
+    inline bool ScopedCharge::Resize(uint64_t bytes) noexcept
+    {
+        // Shrinking Always Succeeds, Growing Is Charged For The Difference Only
+        if (bytes <= m_bytes)
+        {
+            m_ledger.Credit(m_category, m_bytes - bytes);
+            m_bytes = bytes;
+            return m_granted = true;
+        }
+        m_granted = m_ledger.Charge(m_category, bytes - m_bytes);
+        if (m_granted) m_bytes = bytes;
+        return m_granted;
+    }
+
+    inline bool ScopedCharge::Granted() const noexcept
+    {
+        return m_granted;
+    }
+
+    inline uint64_t ScopedCharge::Bytes() const noexcept
+    {
+        return m_bytes;
+    }
+
+    inline ScopedLimitSuspension::ScopedLimitSuspension(MemoryLedger& ledger) noexcept
+        : m_ledger{ ledger }
+    {
+        m_ledger.SuspendLimit();
+    }
+
+    inline ScopedLimitSuspension::~ScopedLimitSuspension()
+    {
+        m_ledger.ResumeLimit();
+    }
+}
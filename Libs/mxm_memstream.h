@@ -0,0 +1,145 @@
+////////////////  Developed By Hamid.Memar (2023-Revised)  ////////////////
+///////////////   Licensed Under MIT Terms And Arguments   ////////////////
+
+#pragma once
+
+#include <streambuf>
+#include <ostream>
+#include <istream>
+
+namespace MemoryStreams
+{
+    // Stream buffer over a fixed, caller-owned memory region.
+    // Writing past the end of the region fails instead of reallocating.
+    class RegionBuffer : public std::streambuf
+    {
+    public:
+        RegionBuffer(void* region, size_t size) noexcept;
+
+        size_t Written() const noexcept;
+
+        size_t Capacity() const noexcept;
+
+    private:
+        RegionBuffer(const RegionBuffer&) = delete;
+        RegionBuffer& operator=(const RegionBuffer&) = delete;
+
+    private:
+        char* m_region;
+        size_t m_size;
+    };
+
+    // Read-only stream buffer over a caller-owned memory region, seekable.
+    class RegionReadBuffer : public std::streambuf
+    {
+    public:
+        RegionReadBuffer(const void* region, size_t size) noexcept;
+
+    protected:
+        pos_type seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode which) override;
+
+        pos_type seekpos(pos_type position, std::ios_base::openmode which) override;
+
+    private:
+        RegionReadBuffer(const RegionReadBuffer&) = delete;
+        RegionReadBuffer& operator=(const RegionReadBuffer&) = delete;
+
+    private:
+        char* m_region;
+        size_t m_size;
+    };
+
+    // Output stream that writes directly into a fixed memory region,
+    // used to inflate zip entries straight into their final destination.
+    class RegionOutStream : public std::ostream
+    {
+    public:
+        RegionOutStream(void* region, size_t size);
+
+        size_t Written() const noexcept;
+
+        bool Complete() const noexcept;
+
+    private:
+        RegionBuffer m_buffer;
+    };
+
+    // Input stream that reads an existing memory region without copying it,
+    // used to feed captured channels to the compressor.
+    class RegionInStream : public std::istream
+    {
+    public:
+        RegionInStream(const void* region, size_t size);
+
+    private:
+        RegionReadBuffer m_buffer;
+    };
+
+    inline RegionBuffer::RegionBuffer(void* region, size_t size) noexcept
+        : m_region{ static_cast<char*>(region) }
+        , m_size{ size }
+    {
+        setp(m_region, m_region + m_size);
+    }
+
+    inline size_t RegionBuffer::Written() const noexcept
+    {
+        return static_cast<size_t>(pptr() - pbase());
+    }
+
+    inline size_t RegionBuffer::Capacity() const noexcept
+    {
+        return m_size;
+    }
+
+    inline RegionOutStream::RegionOutStream(void* region, size_t size)
+        : std::ostream{ nullptr }
+        , m_buffer{ region, size }
+    {
+        rdbuf(&m_buffer);
+    }
+
+    inline size_t RegionOutStream::Written() const noexcept
+    {
+        return m_buffer.Written();
+    }
+
+    inline bool RegionOutStream::Complete() const noexcept
+    {
+        return !fail() && m_buffer.Written() == m_buffer.Capacity();
+    }
+
+    inline RegionReadBuffer::RegionReadBuffer(const void* region, size_t size) noexcept
+        : m_region{ const_cast<char*>(static_cast<const char*>(region)) }
+        , m_size{ size }
+    {
+        setg(m_region, m_region, m_region + m_size);
+    }
+
+    inline RegionReadBuffer::pos_type RegionReadBuffer::seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode which)
+    {
+        if (!(which & std::ios_base::in)) return pos_type(off_type(-1));
+
+        off_type base = 0;
+        if (direction == std::ios_base::cur) base = gptr() - eback();
+        if (direction == std::ios_base::end) base = static_cast<off_type>(m_size);
+
+        off_type target = base + offset;
+        if (target < 0 || target > static_cast<off_type>(m_size)) return pos_type(off_type(-1));
+
+        setg(m_region, m_region + target, m_region + m_size);
+        return pos_type(target);
+    }
+
+    inline RegionReadBuffer::pos_type RegionReadBuffer::seekpos(pos_type position, std::ios_base::openmode which)
+    {
+        return seekoff(off_type(position), std::ios_base::beg, which);
+    }
+
+    inline RegionInStream::RegionInStream(const void* region, size_t size)
+        : std::istream{ nullptr }
+        , m_buffer{ region, size }
+    {
+        rdbuf(&m_buffer);
+    }
+}
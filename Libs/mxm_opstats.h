@@ -0,0 +1,372 @@
+////////////////  Developed By Hamid.Memar (2023-Revised)  ////////////////
+///////////////   Licensed Under MIT Terms And Arguments   ////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "mxm_memledger.h"
+#include "mxm_tracer.h"
+
+namespace OperationStats
+{
+    // Time and bytes spent in one named stage, stages may nest
+    struct StageStat
+    {
+        std::string name;
+        double milliseconds;
+        uint64_t bytes;
+        uint32_t calls;
+    };
+
+    // One package entry, sizes in bytes
+    struct ChannelStat
+    {
+        std::string name;
+        uint64_t rawBytes;
+        uint64_t compressedBytes;
+        double milliseconds;        // Compression or inflation time
+    };
+
+    // Ledger bytes of one category, relative to the start of the operation
+    struct MemoryStat
+    {
+        std::string name;
+        uint64_t peakBytes;
+        uint64_t retainedBytes;     // Still charged when the operation ended, e.g. undo records
+    };
+
+    // Everything recorded between the outermost Begin() and End()
+    struct OperationReport
+    {
+        std::string kind;
+        std::string target;
+        double milliseconds;
+        uint64_t rawBytes;
+        uint64_t packageBytes;
+        bool succeeded;
+        uint64_t peakMemory;
+        double maxError;            // Reconstruction error of lossy encodes, scene units
+        double rmsError;
+        std::vector<StageStat> stages;
+        std::vector<ChannelStat> channels;
+        std::vector<MemoryStat> memory;
+    };
+
+    // Totals of every finished operation of one kind since the last Reset()
+    struct Aggregate
+    {
+        std::string kind;
+        uint64_t count;
+        uint64_t failed;
+        double milliseconds;
+        double minMilliseconds;
+        double maxMilliseconds;
+        uint64_t rawBytes;
+        uint64_t packageBytes;
+        uint64_t maxPeakMemory;
+        std::vector<StageStat> stages;
+    };
+
+    // Collects stage timings of the operation in flight on the thread that began it.
+    // Nested operations fold into the outermost one, and stages recorded from any
+    // other thread are ignored, so background work never pollutes a report.
+    // An attached ledger is opened and closed with the outermost operation.
+    class StatsRecorder
+    {
+    public:
+        StatsRecorder() = default;
+
+        void Begin(const char* kind, const char* target);
+
+        void End(bool succeeded);
+
+        bool IsRecording() const;
+
+        void AddStage(const char* name, double milliseconds, uint64_t bytes);
+
+        void AddChannel(const char* name, uint64_t rawBytes, uint64_t compressedBytes, double milliseconds);
+
+        void AddBytes(uint64_t rawBytes, uint64_t packageBytes);
+
+        void SetError(double maxError, double rmsError);
+
+        OperationReport Last() const;
+
+        std::vector<Aggregate> Aggregates() const;
+
+        void Reset();
+
+        void AttachLedger(MemoryLedgers::MemoryLedger* ledger);
+
+        void SetListener(std::function<void(const OperationReport&)> listener);
+
+    private:
+        StatsRecorder(const StatsRecorder&) = delete;
+        StatsRecorder& operator=(const StatsRecorder&) = delete;
+
+        using clock = std::chrono::steady_clock;
+
+        static void MergeStage(std::vector<StageStat>& stages, const char* name, double milliseconds, uint64_t bytes, uint32_t calls);
+
+    private:
+        mutable std::mutex m_lock;
+        int m_depth = 0;
+        std::thread::id m_owner;
+        clock::time_point m_start;
+        OperationReport m_current;
+        OperationReport m_last{};
+        std::vector<Aggregate> m_aggregates;
+        MemoryLedgers::MemoryLedger* m_ledger = nullptr;
+        std::function<void(const OperationReport&)> m_listener;
+    };
+
+    // Adds the lifetime of the scope to a stage of the recorder's current operation,
+    // and to the trace as a span when tracing is enabled
+    class ScopedStage
+    {
+    public:
+        ScopedStage(StatsRecorder& recorder, const char* name, uint64_t bytes = 0) noexcept;
+
+        ~ScopedStage();
+
+        void AddBytes(uint64_t bytes) noexcept;
+
+    private:
+        ScopedStage(const ScopedStage&) = delete;
+        ScopedStage& operator=(const ScopedStage&) = delete;
+
+        StatsRecorder& m_recorder;
+        const char* m_name;
+        uint64_t m_bytes;
+        std::chrono::steady_clock::time_point m_start;
+        Tracing::TraceScope m_trace;
+    };
+
+    // Begins an operation on construction and ends it on destruction, failed unless Succeed() was called
+    class ScopedOperation
+    {
+    public:
+        ScopedOperation(StatsRecorder& recorder, const char* kind, const char* target);
+
+        ~ScopedOperation();
+
+        void Succeed() noexcept;
+
+    private:
+        ScopedOperation(const ScopedOperation&) = delete;
+        ScopedOperation& operator=(const ScopedOperation&) = delete;
+
+        StatsRecorder& m_recorder;
+        bool m_succeeded;
+        Tracing::TraceScope m_trace;
+    };
+
+    // Throughput helper, 0 when nothing was timed
+    double MegabytesPerSecond(uint64_t bytes, double milliseconds) noexcept;
+
+    inline void StatsRecorder::Begin(const char* kind, const char* target)
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (m_depth++ > 0) return;
+
+        m_owner = std::this_thread::get_id();
+        m_start = clock::now();
+        m_current = OperationReport{};
+        m_current.kind = kind;
+        m_current.target = target ? target : "";
+        if (m_ledger) m_ledger->BeginOperation();
+    }
+
+    inline void StatsRecorder::End(bool succeeded)
+    {
+        std::unique_lock<std::mutex> guard(m_lock);
+        if (m_depth == 0 || --m_depth > 0) return;
+
+        m_current.milliseconds = std::chrono::duration<double, std::milli>(clock::now() - m_start).count();
+        m_current.succeeded = succeeded;
+        m_owner = std::thread::id();
+
+        // Memory Held By The Operation, Per Ledger Category
+        if (m_ledger)
+        {
+            MemoryLedgers::LedgerStats ledger = m_ledger->EndOperation();
+            m_current.peakMemory = ledger.operationPeak;
+            for (int c = 0; c < MemoryLedgers::CategoryCount; c++)
+            {
+                auto& usage = ledger.categories[c];
+                m_current.memory.push_back(MemoryStat{ MemoryLedgers::CategoryName((MemoryLedgers::Category)c), usage.operationPeak, usage.operationCurrent });
+            }
+        }
+
+        // Session Totals Per Kind
+        Aggregate* aggregate = nullptr;
+        for (auto& candidate : m_aggregates) if (candidate.kind == m_current.kind) aggregate = &candidate;
+        if (!aggregate)
+        {
+            m_aggregates.push_back(Aggregate{});
+            aggregate = &m_aggregates.back();
+            aggregate->kind = m_current.kind;
+            aggregate->minMilliseconds = m_current.milliseconds;
+        }
+        aggregate->count++;
+        if (!succeeded) aggregate->failed++;
+        aggregate->milliseconds += m_current.milliseconds;
+        aggregate->minMilliseconds = std::min<double>(aggregate->minMilliseconds, m_current.milliseconds);
+        aggregate->maxMilliseconds = std::max<double>(aggregate->maxMilliseconds, m_current.milliseconds);
+        aggregate->rawBytes += m_current.rawBytes;
+        aggregate->packageBytes += m_current.packageBytes;
+        aggregate->maxPeakMemory = std::max<uint64_t>(aggregate->maxPeakMemory, m_current.peakMemory);
+        for (auto& stage : m_current.stages) MergeStage(aggregate->stages, stage.name.c_str(), stage.milliseconds, stage.bytes, stage.calls);
+
+        m_last = std::move(m_current);
+        m_current = OperationReport{};
+
+        // Notified Outside The Lock, The Listener May Query The Recorder
+        if (!m_listener) return;
+        auto listener = m_listener;
+        OperationReport last = m_last;
+        guard.unlock();
+        listener(last);
+    }
+
+    inline bool StatsRecorder::IsRecording() const
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        return m_depth > 0 && m_owner == std::this_thread::get_id();
+    }
+
+    inline void StatsRecorder::AddStage(const char* name, double milliseconds, uint64_t bytes)
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (m_depth == 0 || m_owner != std::this_thread::get_id()) return;
+        MergeStage(m_current.stages, name, milliseconds, bytes, 1);
+    }
+
+    inline void StatsRecorder::AddChannel(const char* name, uint64_t rawBytes, uint64_t compressedBytes, double milliseconds)
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (m_depth == 0 || m_owner != std::this_thread::get_id()) return;
+
+        // Sizes Are Known Once Per Entry, Times Accumulate Over Repeated Reads
+        for (auto& channel : m_current.channels)
+        {
+            if (channel.name != name) continue;
+            if (rawBytes) channel.rawBytes = rawBytes;
+            if (compressedBytes) channel.compressedBytes = compressedBytes;
+            channel.milliseconds += milliseconds;
+            return;
+        }
+        m_current.channels.push_back(ChannelStat{ name, rawBytes, compressedBytes, milliseconds });
+    }
+
+    inline void StatsRecorder::AddBytes(uint64_t rawBytes, uint64_t packageBytes)
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (m_depth == 0 || m_owner != std::this_thread::get_id()) return;
+        m_current.rawBytes += rawBytes;
+        m_current.packageBytes += packageBytes;
+    }
+
+    inline void StatsRecorder::SetError(double maxError, double rmsError)
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (m_depth == 0 || m_owner != std::this_thread::get_id()) return;
+        m_current.maxError = maxError;
+        m_current.rmsError = rmsError;
+    }
+
+    inline OperationReport StatsRecorder::Last() const
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        return m_last;
+    }
+
+    inline std::vector<Aggregate> StatsRecorder::Aggregates() const
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        return m_aggregates;
+    }
+
+    inline void StatsRecorder::Reset()
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_last = OperationReport{};
+        m_aggregates.clear();
+    }
+
+    inline void StatsRecorder::AttachLedger(MemoryLedgers::MemoryLedger* ledger)
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_ledger = ledger;
+    }
+
+    inline void StatsRecorder::SetListener(std::function<void(const OperationReport&)> listener)
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_listener = std::move(listener);
+    }
+
+    inline void StatsRecorder::MergeStage(std::vector<StageStat>& stages, const char* name, double milliseconds, uint64_t bytes, uint32_t calls)
+    {
+        // First Seen Order, Few Distinct Stages So a Linear Scan Is Enough
+        for (auto& stage : stages)
+        {
+            if (stage.name != name) continue;
+            stage.milliseconds += milliseconds;
+            stage.bytes += bytes;
+            stage.calls += calls;
+            return;
+        }
+        stages.push_back(StageStat{ name, milliseconds, bytes, calls });
+    }
+
+    inline ScopedStage::ScopedStage(StatsRecorder& recorder, const char* name, uint64_t bytes) noexcept
+        : m_recorder{ recorder }
+        , m_name{ name }
+        , m_bytes{ bytes }
+        , m_start{ std::chrono::steady_clock::now() }
+        , m_trace{ name, "stage" }
+    {}
+
+    inline ScopedStage::~ScopedStage()
+    {
+        double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+        m_recorder.AddStage(m_name, milliseconds, m_bytes);
+    }
+
+    inline void ScopedStage::AddBytes(uint64_t bytes) noexcept
+    {
+        m_bytes += bytes;
+    }
+
+    inline ScopedOperation::ScopedOperation(StatsRecorder& recorder, const char* kind, const char* target)
+        : m_recorder{ recorder }
+        , m_succeeded{ false }
+        , m_trace{ kind, "operation", target ? target : "" }
+    {
+        m_recorder.Begin(kind, target);
+    }
+
+    inline ScopedOperation::~ScopedOperation()
+    {
+        m_recorder.End(m_succeeded);
+    }
+
+    inline void ScopedOperation::Succeed() noexcept
+    {
+        m_succeeded = true;
+    }
+
+    inline double MegabytesPerSecond(uint64_t bytes, double milliseconds) noexcept
+    {
+        return milliseconds > 0 ? (bytes / (1024.0 * 1024.0)) / (milliseconds / 1000.0) : 0;
+    }
+}
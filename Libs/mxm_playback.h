@@ -0,0 +1,274 @@
+////////////////  Developed By Hamid.Memar (2023-Revised)  ////////////////
+///////////////   Licensed Under MIT Terms And Arguments   ////////////////
+
+#pragma once
+
+#include <Windows.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Playback
+{
+    using Frame = std::vector<unsigned char>;
+    using SharedFrame = std::shared_ptr<const Frame>;
+
+    // Whole file mapped read-only, pages are faulted in by whoever touches them
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+
+        ~MappedFile();
+
+        bool Open(const wchar_t* file);
+
+        void Close();
+
+        const unsigned char* Data() const noexcept;
+
+        size_t Size() const noexcept;
+
+    private:
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+    private:
+        HANDLE m_file = INVALID_HANDLE_VALUE;
+        HANDLE m_mapping = nullptr;
+        const unsigned char* m_data = nullptr;
+        size_t m_size = 0;
+    };
+
+    // Counters since the ring was created
+    struct RingStats
+    {
+        uint64_t hits;              // Frames already decoded when asked for
+        uint64_t misses;            // Frames decoded on the asking thread
+        uint64_t prefetched;        // Frames decoded by the worker
+        uint64_t evicted;
+        size_t resident;
+        double decodeMilliseconds;  // Spent decoding on either thread
+    };
+
+    // Decoded frames around the current one, the worker decoding ahead in the
+    // direction of playback. Wrapping past the last frame follows looped playback.
+    // Frames behind the current one are kept too, so scrubbing back stays cheap.
+    class FrameRing
+    {
+    public:
+        using Decoder = std::function<bool(size_t index, Frame& frame)>;
+
+        FrameRing(size_t frameCount, size_t capacity, size_t lookahead, Decoder decoder);
+
+        ~FrameRing();
+
+        SharedFrame Acquire(size_t index, int direction);
+
+        RingStats Stats() const;
+
+    private:
+        FrameRing(const FrameRing&) = delete;
+        FrameRing& operator=(const FrameRing&) = delete;
+
+        using clock = std::chrono::steady_clock;
+
+        bool NextWanted(size_t& index) const;
+
+        size_t Rank(size_t index) const noexcept;
+
+        void Insert(size_t index, SharedFrame frame);
+
+        SharedFrame Decode(size_t index);
+
+        void Run();
+
+    private:
+        mutable std::mutex m_lock;
+        std::condition_variable m_wake;
+        std::thread m_worker;
+        std::map<size_t, SharedFrame> m_frames;
+        Decoder m_decoder;
+        size_t m_frameCount;
+        size_t m_capacity;
+        size_t m_lookahead;
+        std::vector<bool> m_failed;     // Never retried by the worker
+        size_t m_current = 0;
+        size_t m_pending = SIZE_MAX;    // Frame the worker is decoding
+        int m_direction = 1;
+        bool m_stopping = false;
+        RingStats m_stats{};
+    };
+
+    inline MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    inline bool MappedFile::Open(const wchar_t* file)
+    {
+        Close();
+        m_file = CreateFileW(file, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (m_file == INVALID_HANDLE_VALUE) return false;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0) { Close(); return false; }
+
+        m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!m_mapping) { Close(); return false; }
+
+        m_data = (const unsigned char*)MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!m_data) { Close(); return false; }
+        m_size = (size_t)size.QuadPart;
+        return true;
+    }
+
+    inline void MappedFile::Close()
+    {
+        if (m_data) UnmapViewOfFile(m_data);
+        if (m_mapping) CloseHandle(m_mapping);
+        if (m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+        m_data = nullptr;
+        m_mapping = nullptr;
+        m_file = INVALID_HANDLE_VALUE;
+        m_size = 0;
+    }
+
+    inline const unsigned char* MappedFile::Data() const noexcept
+    {
+        return m_data;
+    }
+
+    inline size_t MappedFile::Size() const noexcept
+    {
+        return m_size;
+    }
+
+    inline FrameRing::FrameRing(size_t frameCount, size_t capacity, size_t lookahead, Decoder decoder)
+        : m_decoder{ std::move(decoder) }
+        , m_frameCount{ frameCount }
+        , m_capacity{ std::max<size_t>(1, std::min<size_t>(capacity, frameCount)) }
+        , m_lookahead{ std::min<size_t>(lookahead, m_capacity - 1) }
+        , m_failed(frameCount, false)
+    {
+        if (m_lookahead) m_worker = std::thread(&FrameRing::Run, this);
+    }
+
+    inline FrameRing::~FrameRing()
+    {
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            m_stopping = true;
+        }
+        m_wake.notify_all();
+        if (m_worker.joinable()) m_worker.join();
+    }
+
+    inline SharedFrame FrameRing::Acquire(size_t index, int direction)
+    {
+        if (index >= m_frameCount) return nullptr;
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            m_current = index;
+            if (direction) m_direction = direction > 0 ? 1 : -1;
+            m_wake.notify_one();
+
+            auto found = m_frames.find(index);
+            if (found != m_frames.end()) { m_stats.hits++; return found->second; }
+            m_stats.misses++;
+        }
+
+        // Not Resident, Decoded Here Even If The Worker Is On It, Waiting Could Be Longer
+        SharedFrame frame = Decode(index);
+        if (!frame) return nullptr;
+
+        std::lock_guard<std::mutex> guard(m_lock);
+        Insert(index, frame);
+        return frame;
+    }
+
+    inline RingStats FrameRing::Stats() const
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        RingStats stats = m_stats;
+        stats.resident = m_frames.size();
+        return stats;
+    }
+
+    inline bool FrameRing::NextWanted(size_t& index) const
+    {
+        for (size_t step = 1; step <= m_lookahead; step++)
+        {
+            size_t candidate = m_direction > 0 ? (m_current + step) % m_frameCount : (m_current + m_frameCount - step % m_frameCount) % m_frameCount;
+            if (candidate == m_pending || m_failed[candidate] || m_frames.count(candidate)) continue;
+            index = candidate;
+            return true;
+        }
+        return false;
+    }
+
+    inline size_t FrameRing::Rank(size_t index) const noexcept
+    {
+        // Frames Ahead Rank By Distance, Frames Behind After Every Frame Of The Lookahead
+        size_t ahead = m_direction > 0 ? (index + m_frameCount - m_current) % m_frameCount : (m_current + m_frameCount - index) % m_frameCount;
+        if (ahead <= m_lookahead) return ahead;
+        return m_lookahead + (m_frameCount - ahead);
+    }
+
+    inline void FrameRing::Insert(size_t index, SharedFrame frame)
+    {
+        m_frames[index] = std::move(frame);
+        while (m_frames.size() > m_capacity)
+        {
+            auto worst = m_frames.begin();
+            for (auto it = m_frames.begin(); it != m_frames.end(); ++it)
+                if (Rank(it->first) > Rank(worst->first)) worst = it;
+            m_frames.erase(worst);
+            m_stats.evicted++;
+        }
+    }
+
+    inline SharedFrame FrameRing::Decode(size_t index)
+    {
+        auto start = clock::now();
+        auto frame = std::make_shared<Frame>();
+        bool decoded = m_decoder(index, *frame);
+        double milliseconds = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_stats.decodeMilliseconds += milliseconds;
+        return decoded ? frame : nullptr;
+    }
+
+    inline void FrameRing::Run()
+    {
+        std::unique_lock<std::mutex> guard(m_lock);
+        for (;;)
+        {
+            size_t index = 0;
+            m_wake.wait(guard, [&] { return m_stopping || NextWanted(index); });
+            if (m_stopping) return;
+
+            m_pending = index;
+            guard.unlock();
+            SharedFrame frame = Decode(index);
+            guard.lock();
+            m_pending = SIZE_MAX;
+
+            // Playback May Have Moved On, Only Frames Still Ahead Are Kept
+            if (!frame) m_failed[index] = true;
+            else if (Rank(index) <= m_lookahead)
+            {
+                Insert(index, std::move(frame));
+                m_stats.prefetched++;
+            }
+        }
+    }
+}
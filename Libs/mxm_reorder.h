@@ -0,0 +1,200 @@
+////////////////  Developed By Hamid.Memar (2023-Revised)  ////////////////
+///////////////   Licensed Under MIT Terms And Arguments   ////////////////
+
+#pragma once
+
+#include <ppl.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Reordering
+{
+    // Layout compatible with Point3
+    struct Position
+    {
+        float x, y, z;
+    };
+
+    // 21 bits per axis, interleaved x y z from the lowest bit
+    uint64_t MortonCode(uint32_t x, uint32_t y, uint32_t z) noexcept;
+
+    // Vertices sorted along a Z-order curve over their bounds, neighbours in space
+    // end up neighbours in the arrays. Returns the old index of every new vertex.
+    std::vector<int> SpatialOrder(const Position* positions, size_t count);
+
+    // Faces ordered for a simulated LRU vertex cache, Forsyth's linear-speed optimiser
+    // generalised to polygons. Whenever the cache runs dry the walk restarts from the
+    // lowest numbered vertex with faces left, so spatially numbered vertices keep the
+    // restarts local. Returns the old index of every new face.
+    std::vector<int> CacheOrder(const int* degrees, const int* corners, size_t faceCount, size_t vertexCount, int cacheSize = 32);
+
+    // New index of every element in order of first reference, unreferenced ones appended
+    std::vector<int> FirstUseRemap(const int* corners, size_t cornerCount, size_t count);
+
+    // New index of every element from the old index of every new one
+    std::vector<int> InvertOrder(const std::vector<int>& order);
+
+    inline uint64_t MortonCode(uint32_t x, uint32_t y, uint32_t z) noexcept
+    {
+        auto spread = [](uint64_t v)
+        {
+            v &= 0x1fffff;
+            v = (v | v << 32) & 0x1f00000000ffffull;
+            v = (v | v << 16) & 0x1f0000ff0000ffull;
+            v = (v | v << 8) & 0x100f00f00f00f00full;
+            v = (v | v << 4) & 0x10c30c30c30c30c3ull;
+            v = (v | v << 2) & 0x1249249249249249ull;
+            return v;
+        };
+        return spread(x) | spread(y) << 1 | spread(z) << 2;
+    }
+
+    inline std::vector<int> SpatialOrder(const Position* positions, size_t count)
+    {
+        std::vector<int> order(count);
+        if (!count) return order;
+
+        // Every Axis Quantised Over Its Own Extent
+        Position low = positions[0], high = positions[0];
+        for (size_t i = 1; i < count; i++)
+        {
+            low.x = std::min<float>(low.x, positions[i].x); high.x = std::max<float>(high.x, positions[i].x);
+            low.y = std::min<float>(low.y, positions[i].y); high.y = std::max<float>(high.y, positions[i].y);
+            low.z = std::min<float>(low.z, positions[i].z); high.z = std::max<float>(high.z, positions[i].z);
+        }
+        const double cells = (1 << 21) - 1;
+        auto axis = [&](float value, float origin, float extent)
+        {
+            return extent > 0 ? (uint32_t)std::min<double>(cells, (value - origin) / extent * cells) : 0u;
+        };
+
+        // Stable Within a Cell, Ties Keep Their Original Order
+        std::vector<std::pair<uint64_t, int>> keys(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            const Position& p = positions[i];
+            keys[i] = std::make_pair(MortonCode(axis(p.x, low.x, high.x - low.x), axis(p.y, low.y, high.y - low.y), axis(p.z, low.z, high.z - low.z)), (int)i);
+        }
+        concurrency::parallel_sort(keys.begin(), keys.end());
+        for (size_t i = 0; i < count; i++) order[i] = keys[i].second;
+        return order;
+    }
+
+    inline std::vector<int> CacheOrder(const int* degrees, const int* corners, size_t faceCount, size_t vertexCount, int cacheSize)
+    {
+        std::vector<int> order;
+        order.reserve(faceCount);
+        cacheSize = std::max<int>(cacheSize, 4);
+
+        // Corner Offsets & Vertex To Face Adjacency
+        std::vector<size_t> offsets(faceCount + 1, 0);
+        for (size_t f = 0; f < faceCount; f++) offsets[f + 1] = offsets[f] + degrees[f];
+        std::vector<int> remaining(vertexCount, 0);
+        for (size_t c = 0; c < offsets[faceCount]; c++) remaining[corners[c]]++;
+        std::vector<size_t> first(vertexCount + 1, 0);
+        for (size_t v = 0; v < vertexCount; v++) first[v + 1] = first[v] + remaining[v];
+        std::vector<int> adjacency(offsets[faceCount]);
+        std::vector<size_t> fill(first.begin(), first.end() - 1);
+        for (size_t f = 0; f < faceCount; f++)
+            for (size_t c = offsets[f]; c < offsets[f + 1]; c++) adjacency[fill[corners[c]]++] = (int)f;
+
+        // Corners Of The Last Face Score Flat, Older Entries Decay, Lonely Vertices Get a Boost
+        auto score = [&](int position, int valence, int recent)
+        {
+            if (valence == 0) return -1.0f;
+            float value = 0;
+            if (position >= 0)
+                value = position < recent ? 0.75f : std::pow(1.0f - (float)(position - recent) / (cacheSize - recent), 1.5f);
+            return value + 2.0f / std::sqrt((float)valence);
+        };
+        std::vector<int> cachePosition(vertexCount, -1);
+        std::vector<float> vertexScore(vertexCount), faceScore(faceCount, 0.0f);
+        for (size_t v = 0; v < vertexCount; v++) vertexScore[v] = score(-1, remaining[v], 0);
+        for (size_t f = 0; f < faceCount; f++)
+            for (size_t c = offsets[f]; c < offsets[f + 1]; c++) faceScore[f] += vertexScore[corners[c]];
+
+        // Faces Without Corners Touch No Vertex, Emitted Up Front
+        std::vector<bool> emitted(faceCount, false);
+        for (size_t f = 0; f < faceCount; f++) if (!degrees[f]) { emitted[f] = true; order.push_back((int)f); }
+
+        std::vector<int> cache, next;
+        std::vector<size_t> stamp(vertexCount, SIZE_MAX);
+        size_t cursor = 0;
+        int best = -1;
+        while (order.size() < faceCount)
+        {
+            // Restart From The Lowest Numbered Vertex With Faces Left
+            if (best < 0)
+            {
+                while (cursor < vertexCount && remaining[cursor] == 0) cursor++;
+                if (cursor == vertexCount) break;
+                for (size_t a = first[cursor]; a < first[cursor + 1]; a++)
+                {
+                    int f = adjacency[a];
+                    if (!emitted[f] && (best < 0 || faceScore[f] > faceScore[best])) best = f;
+                }
+            }
+
+            // Emit
+            emitted[best] = true;
+            order.push_back(best);
+            size_t step = order.size();
+            next.clear();
+            for (size_t c = offsets[best]; c < offsets[best + 1]; c++)
+            {
+                int v = corners[c];
+                remaining[v]--;
+                if (stamp[v] != step) { stamp[v] = step; next.push_back(v); }
+            }
+            int recent = std::min<int>((int)next.size(), cacheSize / 2);
+            for (int v : cache) if (stamp[v] != step) { stamp[v] = step; next.push_back(v); }
+
+            // New Positions, Score Changes Spread To The Faces Still Waiting
+            for (size_t k = 0; k < next.size(); k++)
+            {
+                int v = next[k];
+                cachePosition[v] = k < (size_t)cacheSize ? (int)k : -1;
+                float updated = score(cachePosition[v], remaining[v], recent);
+                float delta = updated - vertexScore[v];
+                vertexScore[v] = updated;
+                for (size_t a = first[v]; a < first[v + 1]; a++)
+                    if (!emitted[adjacency[a]]) faceScore[adjacency[a]] += delta;
+            }
+
+            // Next Face Among Those Touching The Cache
+            best = -1;
+            for (size_t k = 0; k < next.size() && k < (size_t)cacheSize; k++)
+                for (size_t a = first[next[k]]; a < first[next[k] + 1]; a++)
+                {
+                    int f = adjacency[a];
+                    if (!emitted[f] && (best < 0 || faceScore[f] > faceScore[best])) best = f;
+                }
+            if (next.size() > (size_t)cacheSize) next.resize(cacheSize);
+            cache.swap(next);
+        }
+        return order;
+    }
+
+    inline std::vector<int> FirstUseRemap(const int* corners, size_t cornerCount, size_t count)
+    {
+        std::vector<int> remap(count, -1);
+        int next = 0;
+        for (size_t c = 0; c < cornerCount; c++)
+        {
+            int id = corners[c];
+            if (id >= 0 && (size_t)id < count && remap[id] < 0) remap[id] = next++;
+        }
+        for (size_t i = 0; i < count; i++) if (remap[i] < 0) remap[i] = next++;
+        return remap;
+    }
+
+    inline std::vector<int> InvertOrder(const std::vector<int>& order)
+    {
+        std::vector<int> inverse(order.size());
+        for (size_t i = 0; i < order.size(); i++) inverse[order[i]] = (int)i;
+        return inverse;
+    }
+}
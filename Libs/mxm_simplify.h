@@ -0,0 +1,203 @@
+////////////////  Developed By Hamid.Memar (2023-Revised)  ////////////////
+///////////////   Licensed Under MIT Terms And Arguments   ////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+namespace Simplification
+{
+    // Layout compatible with Point3
+    struct LodVertex
+    {
+        float x, y, z;
+    };
+
+    // Source is the face the triangle was cut from, its attributes carry over
+    struct LodTriangle
+    {
+        int v[3];
+        int source;
+    };
+
+    struct LodMesh
+    {
+        std::vector<LodVertex> vertices;
+        std::vector<LodTriangle> triangles;
+    };
+
+    // Symmetric 4x4 plane quadric, upper 3x3, linear part and constant
+    struct Quadric
+    {
+        double a00, a01, a02, a11, a12, a22;
+        double b0, b1, b2;
+        double c;
+
+        void AddPlane(double nx, double ny, double nz, double d, double weight) noexcept;
+
+        bool Minimize(double& x, double& y, double& z) const noexcept;
+    };
+
+    // LodVertex clustering with quadric error placement. Vertices falling in the same
+    // grid cell merge into one, placed where the summed plane quadrics of their
+    // triangles are smallest, so flat areas collapse while creases keep their shape.
+    // Linear in the mesh size, independent levels may be built concurrently.
+    LodMesh ClusterVertices(const LodVertex* vertices, size_t vertexCount, const LodTriangle* triangles, size_t triangleCount, int resolution);
+
+    // Grid refined until the result lands within reach of the target triangle count
+    LodMesh Simplify(const LodVertex* vertices, size_t vertexCount, const LodTriangle* triangles, size_t triangleCount, size_t targetTriangles);
+
+    inline void Quadric::AddPlane(double nx, double ny, double nz, double d, double weight) noexcept
+    {
+        a00 += weight * nx * nx; a01 += weight * nx * ny; a02 += weight * nx * nz;
+        a11 += weight * ny * ny; a12 += weight * ny * nz; a22 += weight * nz * nz;
+        b0 += weight * d * nx; b1 += weight * d * ny; b2 += weight * d * nz;
+        c += weight * d * d;
+    }
+
+    inline bool Quadric::Minimize(double& x, double& y, double& z) const noexcept
+    {
+        // Cramer's Rule On A p = -b, Near Singular Systems Fall Back To The Mean
+        double c00 = a11 * a22 - a12 * a12, c01 = a02 * a12 - a01 * a22, c02 = a01 * a12 - a02 * a11;
+        double det = a00 * c00 + a01 * c01 + a02 * c02;
+        double scale = a00 + a11 + a22;
+        if (!(std::fabs(det) > 1e-9 * scale * scale * scale) || scale <= 0) return false;
+
+        double c11 = a00 * a22 - a02 * a02, c12 = a01 * a02 - a00 * a12, c22 = a00 * a11 - a01 * a01;
+        x = -(c00 * b0 + c01 * b1 + c02 * b2) / det;
+        y = -(c01 * b0 + c11 * b1 + c12 * b2) / det;
+        z = -(c02 * b0 + c12 * b1 + c22 * b2) / det;
+        return true;
+    }
+
+    inline LodMesh ClusterVertices(const LodVertex* vertices, size_t vertexCount, const LodTriangle* triangles, size_t triangleCount, int resolution)
+    {
+        LodMesh simplified;
+        if (!vertexCount || !triangleCount) return simplified;
+
+        // Cubic Cells, The Longest Side Split Into resolution Cells
+        LodVertex low = vertices[0], high = vertices[0];
+        for (size_t i = 1; i < vertexCount; i++)
+        {
+            low.x = std::min<float>(low.x, vertices[i].x); high.x = std::max<float>(high.x, vertices[i].x);
+            low.y = std::min<float>(low.y, vertices[i].y); high.y = std::max<float>(high.y, vertices[i].y);
+            low.z = std::min<float>(low.z, vertices[i].z); high.z = std::max<float>(high.z, vertices[i].z);
+        }
+        double extent = std::max<double>({ (double)high.x - low.x, (double)high.y - low.y, (double)high.z - low.z, 1e-12 });
+        resolution = std::min<int>(std::max<int>(resolution, 1), (1 << 20) - 1);
+        double cell = extent / resolution;
+
+        // Cell Of Every LodVertex, Occupied Cells Numbered In Key Order
+        auto axis = [&](float value, float origin) { return std::min<uint64_t>((uint64_t)((value - origin) / cell), (uint64_t)resolution); };
+        std::vector<uint64_t> keys(vertexCount);
+        for (size_t i = 0; i < vertexCount; i++)
+            keys[i] = axis(vertices[i].x, low.x) << 42 | axis(vertices[i].y, low.y) << 21 | axis(vertices[i].z, low.z);
+        std::vector<uint64_t> cells(keys);
+        std::sort(cells.begin(), cells.end());
+        cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+        std::vector<int> cluster(vertexCount);
+        for (size_t i = 0; i < vertexCount; i++) cluster[i] = (int)(std::lower_bound(cells.begin(), cells.end(), keys[i]) - cells.begin());
+
+        // Area Weighted Plane Quadrics, Plus Positions For The Fallback Mean
+        std::vector<Quadric> quadrics(cells.size(), Quadric{});
+        std::vector<double> sums(cells.size() * 4, 0.0);
+        for (size_t i = 0; i < vertexCount; i++)
+        {
+            double* sum = &sums[cluster[i] * 4];
+            sum[0] += vertices[i].x; sum[1] += vertices[i].y; sum[2] += vertices[i].z; sum[3] += 1;
+        }
+        for (size_t t = 0; t < triangleCount; t++)
+        {
+            const LodVertex& p = vertices[triangles[t].v[0]];
+            const LodVertex& q = vertices[triangles[t].v[1]];
+            const LodVertex& r = vertices[triangles[t].v[2]];
+            double ux = (double)q.x - p.x, uy = (double)q.y - p.y, uz = (double)q.z - p.z;
+            double vx = (double)r.x - p.x, vy = (double)r.y - p.y, vz = (double)r.z - p.z;
+            double nx = uy * vz - uz * vy, ny = uz * vx - ux * vz, nz = ux * vy - uy * vx;
+            double length = std::sqrt(nx * nx + ny * ny + nz * nz);
+            if (length <= 0) continue;
+            nx /= length; ny /= length; nz /= length;
+            double d = -(nx * p.x + ny * p.y + nz * p.z);
+            for (int k = 0; k < 3; k++) quadrics[cluster[triangles[t].v[k]]].AddPlane(nx, ny, nz, d, length * 0.5);
+        }
+
+        // Representatives, Kept Within Reach Of Their Cell
+        simplified.vertices.resize(cells.size());
+        for (size_t c = 0; c < cells.size(); c++)
+        {
+            const double* sum = &sums[c * 4];
+            double mx = sum[0] / sum[3], my = sum[1] / sum[3], mz = sum[2] / sum[3];
+            double x, y, z;
+            bool placed = quadrics[c].Minimize(x, y, z) &&
+                std::fabs(x - mx) <= cell && std::fabs(y - my) <= cell && std::fabs(z - mz) <= cell;
+            simplified.vertices[c] = placed ? LodVertex{ (float)x, (float)y, (float)z } : LodVertex{ (float)mx, (float)my, (float)mz };
+        }
+
+        // Triangles Spanning Three Clusters Survive, Duplicates Dropped
+        std::vector<LodTriangle> kept;
+        kept.reserve(triangleCount / 2);
+        for (size_t t = 0; t < triangleCount; t++)
+        {
+            LodTriangle triangle{ { cluster[triangles[t].v[0]], cluster[triangles[t].v[1]], cluster[triangles[t].v[2]] }, triangles[t].source };
+            if (triangle.v[0] == triangle.v[1] || triangle.v[1] == triangle.v[2] || triangle.v[0] == triangle.v[2]) continue;
+            kept.push_back(triangle);
+        }
+        std::vector<std::tuple<int, int, int, size_t>> corners(kept.size());
+        for (size_t i = 0; i < kept.size(); i++)
+        {
+            int a = kept[i].v[0], b = kept[i].v[1], c = kept[i].v[2];
+            if (a > b) std::swap(a, b);
+            if (b > c) std::swap(b, c);
+            if (a > b) std::swap(a, b);
+            corners[i] = std::make_tuple(a, b, c, i);
+        }
+        std::sort(corners.begin(), corners.end());
+        std::vector<bool> duplicate(kept.size(), false);
+        for (size_t i = 1; i < corners.size(); i++)
+        {
+            auto& a = corners[i - 1];
+            auto& b = corners[i];
+            duplicate[std::get<3>(b)] = std::get<0>(a) == std::get<0>(b) && std::get<1>(a) == std::get<1>(b) && std::get<2>(a) == std::get<2>(b);
+        }
+
+        // Compact, Clusters Left Without Triangles Are Dropped
+        std::vector<int> remap(cells.size(), -1);
+        std::vector<LodVertex> used;
+        for (size_t i = 0; i < kept.size(); i++)
+        {
+            if (duplicate[i]) continue;
+            LodTriangle triangle = kept[i];
+            for (int k = 0; k < 3; k++)
+            {
+                int& slot = remap[triangle.v[k]];
+                if (slot < 0) { slot = (int)used.size(); used.push_back(simplified.vertices[triangle.v[k]]); }
+                triangle.v[k] = slot;
+            }
+            simplified.triangles.push_back(triangle);
+        }
+        simplified.vertices.swap(used);
+        return simplified;
+    }
+
+    inline LodMesh Simplify(const LodVertex* vertices, size_t vertexCount, const LodTriangle* triangles, size_t triangleCount, size_t targetTriangles)
+    {
+        // Surface Cells Grow With The Square Of The Resolution, About Two Triangles Each
+        targetTriangles = std::max<size_t>(targetTriangles, 4);
+        int resolution = std::max<int>(2, (int)std::sqrt(targetTriangles / 2.0));
+        LodMesh simplified = ClusterVertices(vertices, vertexCount, triangles, triangleCount, resolution);
+        for (int pass = 0; pass < 4; pass++)
+        {
+            double ratio = (double)simplified.triangles.size() / targetTriangles;
+            if (ratio > 0.7 && ratio < 1.4) break;
+            int next = std::max<int>(2, (int)(resolution / std::sqrt(std::max<double>(ratio, 1e-3))));
+            if (next == resolution) break;
+            resolution = next;
+            simplified = ClusterVertices(vertices, vertexCount, triangles, triangleCount, resolution);
+        }
+        return simplified;
+    }
+}
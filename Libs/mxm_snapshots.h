@@ -0,0 +1,181 @@
+////////////////  Developed By Hamid.Memar (2023-Revised)  ////////////////
+///////////////   Licensed Under MIT Terms And Arguments   ////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Snapshots
+{
+    // One in-memory package, ids grow monotonically and double as age
+    struct Snapshot
+    {
+        uint64_t id;
+        uint64_t owner;             // Node handle the snapshot was taken from
+        int64_t timestamp;          // Seconds since epoch
+        size_t rawSize;             // Uncompressed channel bytes
+        std::shared_ptr<const std::vector<unsigned char>> package;
+    };
+
+    // Fixed-size ring of snapshots per owner, all rings sharing one memory budget.
+    // When the budget is exceeded the oldest snapshot of any owner goes first.
+    class SnapshotRing
+    {
+    public:
+        SnapshotRing(size_t budget, size_t ringSize) noexcept;
+
+        uint64_t Push(Snapshot snapshot);
+
+        std::vector<Snapshot> List(uint64_t owner) const;
+
+        bool Find(uint64_t id, Snapshot& snapshot) const;
+
+        bool Remove(uint64_t id);
+
+        void Clear(uint64_t owner);
+
+        void ClearAll();
+
+        void SetLimits(size_t budget, size_t ringSize);
+
+        size_t Size() const;
+
+        size_t Count() const;
+
+    private:
+        SnapshotRing(const SnapshotRing&) = delete;
+        SnapshotRing& operator=(const SnapshotRing&) = delete;
+
+        void Enforce();
+
+        void Drop(std::deque<Snapshot>& ring);
+
+    private:
+        mutable std::mutex m_lock;
+        std::map<uint64_t, std::deque<Snapshot>> m_rings;  // Oldest first
+        size_t m_budget;
+        size_t m_ringSize;
+        size_t m_size;
+        uint64_t m_nextId;
+    };
+
+    inline SnapshotRing::SnapshotRing(size_t budget, size_t ringSize) noexcept
+        : m_budget{ budget }
+        , m_ringSize{ ringSize }
+        , m_size{ 0 }
+        , m_nextId{ 1 }
+    {}
+
+    inline uint64_t SnapshotRing::Push(Snapshot snapshot)
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (!snapshot.package || !m_ringSize || snapshot.package->size() > m_budget) return 0;
+
+        snapshot.id = m_nextId++;
+        m_size += snapshot.package->size();
+        m_rings[snapshot.owner].push_back(snapshot);
+        Enforce();
+        return snapshot.id;
+    }
+
+    inline std::vector<Snapshot> SnapshotRing::List(uint64_t owner) const
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        auto found = m_rings.find(owner);
+        if (found == m_rings.end()) return {};
+        return std::vector<Snapshot>(found->second.begin(), found->second.end());
+    }
+
+    inline bool SnapshotRing::Find(uint64_t id, Snapshot& snapshot) const
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        for (auto& ring : m_rings)
+            for (auto& entry : ring.second)
+                if (entry.id == id) { snapshot = entry; return true; }
+        return false;
+    }
+
+    inline bool SnapshotRing::Remove(uint64_t id)
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        for (auto& ring : m_rings)
+            for (auto it = ring.second.begin(); it != ring.second.end(); ++it)
+                if (it->id == id)
+                {
+                    m_size -= it->package->size();
+                    ring.second.erase(it);
+                    return true;
+                }
+        return false;
+    }
+
+    inline void SnapshotRing::Clear(uint64_t owner)
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        auto found = m_rings.find(owner);
+        if (found == m_rings.end()) return;
+        while (!found->second.empty()) Drop(found->second);
+        m_rings.erase(found);
+    }
+
+    inline void SnapshotRing::ClearAll()
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_rings.clear();
+        m_size = 0;
+    }
+
+    inline void SnapshotRing::SetLimits(size_t budget, size_t ringSize)
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_budget = budget;
+        m_ringSize = ringSize;
+        Enforce();
+    }
+
+    inline size_t SnapshotRing::Size() const
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        return m_size;
+    }
+
+    inline size_t SnapshotRing::Count() const
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        size_t count = 0;
+        for (auto& ring : m_rings) count += ring.second.size();
+        return count;
+    }
+
+    inline void SnapshotRing::Enforce()
+    {
+        // Ring Size Per Owner
+        for (auto& ring : m_rings)
+            while (ring.second.size() > m_ringSize) Drop(ring.second);
+
+        // Shared Budget, Globally Oldest First
+        while (m_size > m_budget)
+        {
+            std::deque<Snapshot>* oldest = nullptr;
+            for (auto& ring : m_rings)
+                if (!ring.second.empty() && (!oldest || ring.second.front().id < oldest->front().id)) oldest = &ring.second;
+            if (!oldest) break;
+            Drop(*oldest);
+        }
+
+        for (auto it = m_rings.begin(); it != m_rings.end();)
+            it = it->second.empty() ? m_rings.erase(it) : std::next(it);
+    }
+
+    inline void SnapshotRing::Drop(std::deque<Snapshot>& ring)
+    {
+        m_size -= ring.front().package->size();
+        ring.pop_front();
+    }
+}
@@ -0,0 +1,544 @@
+////////////////  Developed By Hamid.Memar (2023-Revised)  ////////////////
+///////////////   Licensed Under MIT Terms And Arguments   ////////////////
+
+#pragma once
+
+#include <ppl.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "mxm_animcache.h"
+
+namespace TemporalCodecs
+{
+    // Encoder settings, steps and tolerance in scene units
+    struct CodecSettings
+    {
+        uint32_t codec;             // CodecRaw, CodecDelta or CodecBasis
+        uint32_t keyInterval;       // Frames per delta chain or basis segment
+        float positionStep;         // Delta quantization, decoded positions stay within half a step
+        float normalStep;
+        float basisTolerance;       // RMS error a basis segment may leave
+        uint32_t maxComponents;     // Basis vectors per segment
+    };
+
+    // One frame ready to be written, packed payloads are deflated by the caller
+    struct EncodedFrame
+    {
+        int32_t time;
+        uint32_t codec;
+        std::vector<unsigned char> payload;
+    };
+
+    // Vertex distance between decoded and captured positions
+    struct ErrorStats
+    {
+        double maxError;
+        double sumSquares;
+        uint64_t samples;
+
+        double Rms() const noexcept;
+    };
+
+    constexpr CodecSettings DefaultCodecSettings{ AnimatedCaches::CodecRaw, 16, 0.001f, 1.0f / 4096.0f, 0.001f, 16 };
+
+    // Payloads worth deflating, coefficient frames are a few floats
+    bool IsPacked(uint32_t codec) noexcept;
+
+    // 32-bit words split into byte planes, deflate finds the runs in the high bytes
+    void ShuffleBytes(const void* words, size_t count, unsigned char* planes) noexcept;
+
+    void UnshuffleBytes(const unsigned char* planes, size_t count, void* words) noexcept;
+
+    // Turns captured frames into key, delta or basis frames. Deltas are taken
+    // against what the decoder will reconstruct, not the captured frame, so
+    // quantization error never accumulates along a chain. Basis segments are
+    // held until complete, every other codec emits a frame per Push().
+    class TemporalEncoder
+    {
+    public:
+        TemporalEncoder(const CodecSettings& settings, size_t positionFloats, size_t normalFloats);
+
+        void Push(int32_t time, const float* frame);
+
+        void Finish();
+
+        bool Pop(EncodedFrame& frame);
+
+        const ErrorStats& Error() const noexcept;
+
+        size_t SegmentBytes() const noexcept;
+
+    private:
+        TemporalEncoder(const TemporalEncoder&) = delete;
+        TemporalEncoder& operator=(const TemporalEncoder&) = delete;
+
+        void EncodeKey(int32_t time, const float* frame);
+
+        bool EncodeDelta(int32_t time, const float* frame);
+
+        void EncodeSegment();
+
+        void Measure(const float* decoded, const float* captured);
+
+    private:
+        CodecSettings m_settings;
+        size_t m_positionFloats;
+        size_t m_floats;
+        uint32_t m_sinceKey = 0;
+        std::vector<float> m_reference;         // Previous frame as the decoder sees it
+        std::vector<float> m_segment;           // Basis frames waiting for their segment to fill
+        std::vector<int32_t> m_segmentTimes;
+        std::deque<EncodedFrame> m_ready;
+        ErrorStats m_error{};
+    };
+
+    // Reconstructs the frames of one cache. A delta frame continues from the last
+    // decoded frame when it lies on the same chain, so sequential playback decodes
+    // every delta once, and a basis segment stays resident while its frames play.
+    // Frames are fetched unpacked through the callback, decoding is serialized.
+    class TemporalDecoder
+    {
+    public:
+        using Fetch = std::function<bool(size_t index, std::vector<unsigned char>& payload)>;
+
+        TemporalDecoder(const AnimatedCaches::CacheHeader& header, const AnimatedCaches::FrameRecord* frames, size_t count);
+
+        bool Decode(size_t index, const Fetch& fetch, float* frame);
+
+        size_t FrameFloats() const noexcept;
+
+    private:
+        TemporalDecoder(const TemporalDecoder&) = delete;
+        TemporalDecoder& operator=(const TemporalDecoder&) = delete;
+
+        bool DecodeChain(size_t index, const Fetch& fetch);
+
+        bool DecodeBasis(size_t index, const Fetch& fetch, float* frame);
+
+    private:
+        std::mutex m_lock;
+        const AnimatedCaches::FrameRecord* m_frames;
+        size_t m_count;
+        size_t m_positionFloats;
+        size_t m_floats;
+        float m_positionStep;
+        float m_normalStep;
+        size_t m_chainIndex = SIZE_MAX;
+        std::vector<float> m_reference;
+        size_t m_basisIndex = SIZE_MAX;
+        uint32_t m_components = 0;
+        std::vector<float> m_basis;             // Mean, then one vector per component
+        std::vector<float> m_keyCoefficients;
+        std::vector<unsigned char> m_payload;
+    };
+
+    // Shared by encoder and decoder, both must round identically
+    inline float Dequantize(float reference, uint32_t word, float step) noexcept
+    {
+        int32_t delta = (int32_t)(word >> 1) ^ -(int32_t)(word & 1);
+        return reference + (float)delta * step;
+    }
+
+    inline void Reconstruct(const float* basis, const float* coefficients, uint32_t components, size_t floats, float* frame)
+    {
+        concurrency::parallel_for(size_t(0), (floats + 65535) / 65536, [&](size_t chunk)
+        {
+            size_t begin = chunk * 65536, end = std::min<size_t>(floats, begin + 65536);
+            for (size_t j = begin; j < end; j++)
+            {
+                float value = basis[j];
+                for (uint32_t k = 0; k < components; k++) value += coefficients[k] * basis[(k + 1) * floats + j];
+                frame[j] = value;
+            }
+        });
+    }
+
+    inline double ErrorStats::Rms() const noexcept
+    {
+        return samples ? std::sqrt(sumSquares / samples) : 0.0;
+    }
+
+    inline bool IsPacked(uint32_t codec) noexcept
+    {
+        return codec == AnimatedCaches::CodecKey || codec == AnimatedCaches::CodecDelta || codec == AnimatedCaches::CodecBasisKey;
+    }
+
+    inline void ShuffleBytes(const void* words, size_t count, unsigned char* planes) noexcept
+    {
+        const unsigned char* bytes = static_cast<const unsigned char*>(words);
+        for (size_t i = 0; i < count; i++)
+            for (size_t b = 0; b < 4; b++) planes[b * count + i] = bytes[i * 4 + b];
+    }
+
+    inline void UnshuffleBytes(const unsigned char* planes, size_t count, void* words) noexcept
+    {
+        unsigned char* bytes = static_cast<unsigned char*>(words);
+        for (size_t i = 0; i < count; i++)
+            for (size_t b = 0; b < 4; b++) bytes[i * 4 + b] = planes[b * count + i];
+    }
+
+    inline TemporalEncoder::TemporalEncoder(const CodecSettings& settings, size_t positionFloats, size_t normalFloats)
+        : m_settings{ settings }
+        , m_positionFloats{ positionFloats }
+        , m_floats{ positionFloats + normalFloats }
+    {
+        m_settings.keyInterval = std::max<uint32_t>(1, m_settings.keyInterval);
+        m_settings.positionStep = std::max<float>(1e-7f, m_settings.positionStep);
+        m_settings.normalStep = std::max<float>(1e-7f, m_settings.normalStep);
+    }
+
+    inline void TemporalEncoder::Push(int32_t time, const float* frame)
+    {
+        switch (m_settings.codec)
+        {
+        case AnimatedCaches::CodecDelta:
+            // Chains Restart Every Interval, Or When a Jump Overflows The Quantizer
+            if (m_sinceKey == 0 || m_sinceKey >= m_settings.keyInterval || !EncodeDelta(time, frame)) EncodeKey(time, frame);
+            m_sinceKey++;
+            break;
+
+        case AnimatedCaches::CodecBasis:
+            m_segment.insert(m_segment.end(), frame, frame + m_floats);
+            m_segmentTimes.push_back(time);
+            if (m_segmentTimes.size() >= m_settings.keyInterval) EncodeSegment();
+            break;
+
+        default:
+        {
+            EncodedFrame encoded{ time, AnimatedCaches::CodecRaw };
+            encoded.payload.assign((const unsigned char*)frame, (const unsigned char*)(frame + m_floats));
+            m_ready.push_back(std::move(encoded));
+            Measure(frame, frame);
+        }
+        }
+    }
+
+    inline void TemporalEncoder::Finish()
+    {
+        if (!m_segmentTimes.empty()) EncodeSegment();
+    }
+
+    inline bool TemporalEncoder::Pop(EncodedFrame& frame)
+    {
+        if (m_ready.empty()) return false;
+        frame = std::move(m_ready.front());
+        m_ready.pop_front();
+        return true;
+    }
+
+    inline const ErrorStats& TemporalEncoder::Error() const noexcept
+    {
+        return m_error;
+    }
+
+    inline size_t TemporalEncoder::SegmentBytes() const noexcept
+    {
+        // Captured Frames Plus Mean & Basis Of a Full Segment
+        if (m_settings.codec != AnimatedCaches::CodecBasis) return m_floats * sizeof(float);
+        size_t components = std::min<size_t>(m_settings.maxComponents, m_settings.keyInterval);
+        return (m_settings.keyInterval + components + 1) * m_floats * sizeof(float);
+    }
+
+    inline void TemporalEncoder::EncodeKey(int32_t time, const float* frame)
+    {
+        EncodedFrame encoded{ time, AnimatedCaches::CodecKey };
+        encoded.payload.resize(m_floats * sizeof(float));
+        ShuffleBytes(frame, m_floats, encoded.payload.data());
+        m_ready.push_back(std::move(encoded));
+
+        m_reference.assign(frame, frame + m_floats);
+        m_sinceKey = 0;
+        Measure(frame, frame);
+    }
+
+    inline bool TemporalEncoder::EncodeDelta(int32_t time, const float* frame)
+    {
+        std::vector<uint32_t> words(m_floats);
+        for (size_t j = 0; j < m_floats; j++)
+        {
+            float step = j < m_positionFloats ? m_settings.positionStep : m_settings.normalStep;
+            double delta = std::nearbyint(((double)frame[j] - m_reference[j]) / step);
+            if (!(std::fabs(delta) < (double)(1 << 30))) return false;
+            int32_t quantized = (int32_t)delta;
+            words[j] = ((uint32_t)quantized << 1) ^ (uint32_t)(quantized >> 31);
+        }
+
+        EncodedFrame encoded{ time, AnimatedCaches::CodecDelta };
+        encoded.payload.resize(m_floats * sizeof(uint32_t));
+        ShuffleBytes(words.data(), m_floats, encoded.payload.data());
+        m_ready.push_back(std::move(encoded));
+
+        for (size_t j = 0; j < m_floats; j++)
+            m_reference[j] = Dequantize(m_reference[j], words[j], j < m_positionFloats ? m_settings.positionStep : m_settings.normalStep);
+        Measure(m_reference.data(), frame);
+        return true;
+    }
+
+    inline void TemporalEncoder::EncodeSegment()
+    {
+        size_t frames = m_segmentTimes.size();
+        size_t floats = m_floats;
+        const float* captured = m_segment.data();
+
+        // Mean Frame
+        std::vector<double> mean(floats, 0.0);
+        for (size_t i = 0; i < frames; i++)
+            for (size_t j = 0; j < floats; j++) mean[j] += captured[i * floats + j];
+        for (auto& value : mean) value /= (double)frames;
+
+        // Gram Matrix Of The Centered Frames, Frames x Frames Instead Of Floats x Floats
+        std::vector<double> gram(frames * frames, 0.0);
+        concurrency::parallel_for(size_t(0), frames, [&](size_t a)
+        {
+            for (size_t b = a; b < frames; b++)
+            {
+                double dot = 0;
+                for (size_t j = 0; j < floats; j++) dot += (captured[a * floats + j] - mean[j]) * (captured[b * floats + j] - mean[j]);
+                gram[a * frames + b] = dot;
+                gram[b * frames + a] = dot;
+            }
+        });
+
+        // Cyclic Jacobi, Eigenvectors In The Columns Of vectors
+        std::vector<double> vectors(frames * frames, 0.0);
+        for (size_t i = 0; i < frames; i++) vectors[i * frames + i] = 1.0;
+        for (int sweep = 0; sweep < 64; sweep++)
+        {
+            double off = 0, diagonal = 0;
+            for (size_t a = 0; a < frames; a++)
+                for (size_t b = 0; b < frames; b++)
+                    (a == b ? diagonal : off) += gram[a * frames + b] * gram[a * frames + b];
+            if (off <= 1e-24 * diagonal || off == 0) break;
+
+            for (size_t p = 0; p < frames; p++)
+                for (size_t q = p + 1; q < frames; q++)
+                {
+                    double apq = gram[p * frames + q];
+                    if (apq == 0) continue;
+                    double theta = (gram[q * frames + q] - gram[p * frames + p]) / (2 * apq);
+                    double t = (theta >= 0 ? 1.0 : -1.0) / (std::fabs(theta) + std::sqrt(theta * theta + 1));
+                    double c = 1 / std::sqrt(t * t + 1), s = t * c;
+                    for (size_t k = 0; k < frames; k++)
+                    {
+                        double akp = gram[k * frames + p], akq = gram[k * frames + q];
+                        gram[k * frames + p] = c * akp - s * akq;
+                        gram[k * frames + q] = s * akp + c * akq;
+                    }
+                    for (size_t k = 0; k < frames; k++)
+                    {
+                        double apk = gram[p * frames + k], aqk = gram[q * frames + k];
+                        gram[p * frames + k] = c * apk - s * aqk;
+                        gram[q * frames + k] = s * apk + c * aqk;
+                    }
+                    for (size_t k = 0; k < frames; k++)
+                    {
+                        double vkp = vectors[k * frames + p], vkq = vectors[k * frames + q];
+                        vectors[k * frames + p] = c * vkp - s * vkq;
+                        vectors[k * frames + q] = s * vkp + c * vkq;
+                    }
+                }
+        }
+
+        // Fewest Components Whose Discarded Energy Stays Under The Tolerance
+        std::vector<size_t> order(frames);
+        for (size_t i = 0; i < frames; i++) order[i] = i;
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return gram[a * frames + a] > gram[b * frames + b]; });
+        double allowed = (double)m_settings.basisTolerance * m_settings.basisTolerance * frames * floats;
+        double residual = 0;
+        for (size_t i = 0; i < frames; i++) residual += std::max<double>(0.0, gram[i * frames + i]);
+        uint32_t components = 0;
+        size_t limit = std::min<size_t>(m_settings.maxComponents, frames > 1 ? frames - 1 : 0);
+        while (components < limit && residual > allowed && gram[order[components] * frames + order[components]] > 0)
+            residual -= gram[order[components] * frames + order[components]], components++;
+
+        // Mean & Unit Basis Vectors, basis_k = Sum Of v_k[i] * (x_i - mean) / sqrt(lambda_k)
+        std::vector<float> basis((components + 1) * floats);
+        for (size_t j = 0; j < floats; j++) basis[j] = (float)mean[j];
+        concurrency::parallel_for(size_t(0), (size_t)components, [&](size_t k)
+        {
+            size_t column = order[k];
+            double scale = 1.0 / std::sqrt(gram[column * frames + column]);
+            float* vector = basis.data() + (k + 1) * floats;
+            for (size_t j = 0; j < floats; j++)
+            {
+                double value = 0;
+                for (size_t i = 0; i < frames; i++) value += vectors[i * frames + column] * (captured[i * floats + j] - mean[j]);
+                vector[j] = (float)(value * scale);
+            }
+        });
+
+        // Coefficients Projected On The Stored Basis, Absorbs Its Rounding
+        std::vector<float> coefficients(frames * components);
+        concurrency::parallel_for(size_t(0), frames * components, [&](size_t n)
+        {
+            size_t i = n / components, k = n % components;
+            const float* vector = basis.data() + (k + 1) * floats;
+            double dot = 0;
+            for (size_t j = 0; j < floats; j++) dot += (double)vector[j] * (captured[i * floats + j] - basis[j]);
+            coefficients[n] = (float)dot;
+        });
+
+        // Key Frame Carries The Basis, The Others Their Coefficients Only
+        for (size_t i = 0; i < frames; i++)
+        {
+            EncodedFrame encoded{ m_segmentTimes[i], i == 0 ? AnimatedCaches::CodecBasisKey : AnimatedCaches::CodecBasis };
+            if (i == 0)
+            {
+                size_t words = components + basis.size();
+                std::vector<float> block(words);
+                std::copy(coefficients.begin(), coefficients.begin() + components, block.begin());
+                std::copy(basis.begin(), basis.end(), block.begin() + components);
+                encoded.payload.resize(sizeof(uint32_t) * 2 + words * sizeof(float));
+                uint32_t layout[2] = { components, 0 };
+                memcpy(encoded.payload.data(), layout, sizeof(layout));
+                ShuffleBytes(block.data(), words, encoded.payload.data() + sizeof(layout));
+            }
+            else
+            {
+                encoded.payload.assign((const unsigned char*)(coefficients.data() + i * components),
+                    (const unsigned char*)(coefficients.data() + (i + 1) * components));
+            }
+            m_ready.push_back(std::move(encoded));
+
+            std::vector<float> decoded(floats);
+            Reconstruct(basis.data(), coefficients.data() + i * components, components, floats, decoded.data());
+            Measure(decoded.data(), captured + i * floats);
+        }
+
+        m_segment.clear();
+        m_segmentTimes.clear();
+    }
+
+    inline void TemporalEncoder::Measure(const float* decoded, const float* captured)
+    {
+        for (size_t j = 0; j + 2 < m_positionFloats; j += 3)
+        {
+            double dx = decoded[j] - captured[j], dy = decoded[j + 1] - captured[j + 1], dz = decoded[j + 2] - captured[j + 2];
+            double squared = dx * dx + dy * dy + dz * dz;
+            m_error.maxError = std::max<double>(m_error.maxError, std::sqrt(squared));
+            m_error.sumSquares += squared;
+            m_error.samples++;
+        }
+    }
+
+    inline TemporalDecoder::TemporalDecoder(const AnimatedCaches::CacheHeader& header, const AnimatedCaches::FrameRecord* frames, size_t count)
+        : m_frames{ frames }
+        , m_count{ count }
+        , m_positionFloats{ (size_t)header.vNum * 3 }
+        , m_floats{ ((size_t)header.vNum + ((header.flags & AnimatedCaches::CacheNormals) ? (size_t)header.nNum : 0)) * 3 }
+        , m_positionStep{ header.positionStep }
+        , m_normalStep{ header.normalStep }
+    {}
+
+    inline size_t TemporalDecoder::FrameFloats() const noexcept
+    {
+        return m_floats;
+    }
+
+    inline bool TemporalDecoder::Decode(size_t index, const Fetch& fetch, float* frame)
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (index >= m_count) return false;
+
+        switch (m_frames[index].codec)
+        {
+        case AnimatedCaches::CodecRaw:
+            if (!fetch(index, m_payload) || m_payload.size() < m_floats * sizeof(float)) return false;
+            memcpy(frame, m_payload.data(), m_floats * sizeof(float));
+            return true;
+
+        case AnimatedCaches::CodecKey:
+        case AnimatedCaches::CodecDelta:
+            if (!DecodeChain(index, fetch)) return false;
+            memcpy(frame, m_reference.data(), m_floats * sizeof(float));
+            return true;
+
+        case AnimatedCaches::CodecBasisKey:
+        case AnimatedCaches::CodecBasis:
+            return DecodeBasis(index, fetch, frame);
+        }
+        return false;
+    }
+
+    inline bool TemporalDecoder::DecodeChain(size_t index, const Fetch& fetch)
+    {
+        // Nearest Key At Or Before The Frame
+        size_t key = index;
+        while (key > 0 && m_frames[key].codec == AnimatedCaches::CodecDelta) key--;
+        if (m_frames[key].codec != AnimatedCaches::CodecKey) return false;
+
+        // Resume The Chain When Already Inside It, Otherwise Start From The Key
+        size_t next = key;
+        if (m_chainIndex != SIZE_MAX && m_chainIndex >= key && m_chainIndex <= index) next = m_chainIndex + 1;
+        else
+        {
+            m_chainIndex = SIZE_MAX;
+            if (!fetch(key, m_payload) || m_payload.size() < m_floats * sizeof(float)) return false;
+            m_reference.resize(m_floats);
+            UnshuffleBytes(m_payload.data(), m_floats, m_reference.data());
+            m_chainIndex = key;
+            next = key + 1;
+        }
+
+        for (size_t i = next; i <= index; i++)
+        {
+            if (!fetch(i, m_payload) || m_payload.size() < m_floats * sizeof(uint32_t)) { m_chainIndex = SIZE_MAX; return false; }
+            const unsigned char* planes = m_payload.data();
+            size_t floats = m_floats, positions = m_positionFloats;
+            float positionStep = m_positionStep, normalStep = m_normalStep;
+            float* reference = m_reference.data();
+            concurrency::parallel_for(size_t(0), (floats + 65535) / 65536, [&](size_t chunk)
+            {
+                size_t begin = chunk * 65536, end = std::min<size_t>(floats, begin + 65536);
+                for (size_t j = begin; j < end; j++)
+                {
+                    uint32_t word = planes[j] | (uint32_t)planes[floats + j] << 8 | (uint32_t)planes[2 * floats + j] << 16 | (uint32_t)planes[3 * floats + j] << 24;
+                    reference[j] = Dequantize(reference[j], word, j < positions ? positionStep : normalStep);
+                }
+            });
+            m_chainIndex = i;
+        }
+        return true;
+    }
+
+    inline bool TemporalDecoder::DecodeBasis(size_t index, const Fetch& fetch, float* frame)
+    {
+        size_t key = index;
+        while (key > 0 && m_frames[key].codec == AnimatedCaches::CodecBasis) key--;
+        if (m_frames[key].codec != AnimatedCaches::CodecBasisKey) return false;
+
+        // Segment Basis, Kept Until Playback Leaves The Segment
+        if (m_basisIndex != key)
+        {
+            m_basisIndex = SIZE_MAX;
+            uint32_t layout[2];
+            if (!fetch(key, m_payload) || m_payload.size() < sizeof(layout)) return false;
+            memcpy(layout, m_payload.data(), sizeof(layout));
+            size_t words = layout[0] + (layout[0] + 1) * m_floats;
+            if (m_payload.size() < sizeof(layout) + words * sizeof(float)) return false;
+
+            std::vector<float> block(words);
+            UnshuffleBytes(m_payload.data() + sizeof(layout), words, block.data());
+            m_components = layout[0];
+            m_keyCoefficients.assign(block.begin(), block.begin() + m_components);
+            m_basis.assign(block.begin() + m_components, block.end());
+            m_basisIndex = key;
+        }
+
+        const float* coefficients = m_keyCoefficients.data();
+        if (index != key)
+        {
+            if (!fetch(index, m_payload) || m_payload.size() < m_components * sizeof(float)) return false;
+            coefficients = (const float*)m_payload.data();
+        }
+        Reconstruct(m_basis.data(), coefficients, m_components, m_floats, frame);
+        return true;
+    }
+}
@@ -0,0 +1,438 @@
+////////////////  Developed By Hamid.Memar (2023-Revised)  ////////////////
+///////////////   Licensed Under MIT Terms And Arguments   ////////////////
+
+#pragma once
+
+#include <cctype>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace TieredStorage
+{
+    using Package = std::vector<unsigned char>;
+    using SharedPackage = std::shared_ptr<const Package>;
+
+    // Most recently written packages kept in RAM, least recently used dropped first.
+    // Readers hold a shared reference, so eviction never frees bytes still being read.
+    class MemoryTier
+    {
+    public:
+        explicit MemoryTier(size_t budget) noexcept;
+
+        void Put(const std::string& key, SharedPackage package);
+
+        SharedPackage Get(const std::string& key);
+
+        void Remove(const std::string& key);
+
+        void Clear();
+
+        void SetBudget(size_t budget);
+
+        size_t Budget() const;
+
+        size_t Size() const;
+
+        size_t Count() const;
+
+    private:
+        MemoryTier(const MemoryTier&) = delete;
+        MemoryTier& operator=(const MemoryTier&) = delete;
+
+        void EvictUntil(size_t size);
+
+    private:
+        using Entry = std::pair<std::string, SharedPackage>;
+
+        mutable std::mutex m_lock;
+        std::list<Entry> m_order;   // Front is most recently used
+        std::unordered_map<std::string, std::list<Entry>::iterator> m_index;
+        size_t m_budget;
+        size_t m_size;
+    };
+
+    // Archive a staged copy was written for, with the size & write time the copy had then.
+    // Kept next to the copy, a copy changed since or written for another archive is never trusted.
+    struct StagedOrigin
+    {
+        std::filesystem::path archive;
+        uint64_t size;
+        int64_t stamp;
+    };
+
+    std::filesystem::path StagedOriginPath(const std::filesystem::path& staged);
+
+    bool WriteStagedOrigin(const std::filesystem::path& staged, const std::filesystem::path& archive);
+
+    // False when the record is missing or the copy no longer has the recorded size & write time
+    bool ReadStagedOrigin(const std::filesystem::path& staged, StagedOrigin& origin);
+
+    // Single background worker copying staged packages to their archive location.
+    // Copies land under a temporary name and are renamed, so the archive never
+    // exposes partial packages. The worker starts on first use and must be
+    // stopped explicitly before the module unloads.
+    class MigrationQueue
+    {
+    public:
+        struct Stats
+        {
+            size_t pending;
+            uint64_t migrated;
+            uint64_t failed;
+            uint64_t migratedBytes;
+        };
+
+        MigrationQueue() = default;
+
+        ~MigrationQueue();
+
+        void Enqueue(const std::filesystem::path& staged, const std::filesystem::path& archive);
+
+        bool IsPending(const std::filesystem::path& archive) const;
+
+        void Cancel(const std::filesystem::path& archive);
+
+        size_t RetryFailed();
+
+        void Flush();
+
+        void Stop();
+
+        void SetStagingRetention(size_t bytes);
+
+        Stats GetStats() const;
+
+    private:
+        MigrationQueue(const MigrationQueue&) = delete;
+        MigrationQueue& operator=(const MigrationQueue&) = delete;
+
+        struct Job
+        {
+            std::filesystem::path staged;
+            std::filesystem::path archive;
+        };
+
+        static std::string Key(const std::filesystem::path& archive);
+
+        void Run();
+
+        bool Migrate(const Job& job, uint64_t& bytes);
+
+        void PruneStaged();
+
+    private:
+        mutable std::mutex m_lock;
+        std::condition_variable m_wake;
+        std::condition_variable m_idle;
+        std::thread m_worker;
+        std::deque<Job> m_jobs;
+        std::vector<Job> m_failed;
+        std::deque<std::pair<std::filesystem::path, uint64_t>> m_migrated;   // Staged copies kept as local tier
+        std::string m_active;
+        bool m_stopping = false;
+        size_t m_retention = 2048ull << 20;
+        uint64_t m_retained = 0;
+        Stats m_stats{};
+    };
+
+    inline MemoryTier::MemoryTier(size_t budget) noexcept
+        : m_budget{ budget }
+        , m_size{ 0 }
+    {}
+
+    inline void MemoryTier::Put(const std::string& key, SharedPackage package)
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        auto found = m_index.find(key);
+        if (found != m_index.end())
+        {
+            m_size -= found->second->second->size();
+            m_order.erase(found->second);
+            m_index.erase(found);
+        }
+        if (!package || package->size() > m_budget) return;
+
+        EvictUntil(m_budget - package->size());
+        m_size += package->size();
+        m_order.emplace_front(key, std::move(package));
+        m_index[key] = m_order.begin();
+    }
+
+    inline SharedPackage MemoryTier::Get(const std::string& key)
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        auto found = m_index.find(key);
+        if (found == m_index.end()) return nullptr;
+        m_order.splice(m_order.begin(), m_order, found->second);
+        return found->second->second;
+    }
+
+    inline void MemoryTier::Remove(const std::string& key)
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        auto found = m_index.find(key);
+        if (found == m_index.end()) return;
+        m_size -= found->second->second->size();
+        m_order.erase(found->second);
+        m_index.erase(found);
+    }
+
+    inline void MemoryTier::Clear()
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_order.clear();
+        m_index.clear();
+        m_size = 0;
+    }
+
+    inline void MemoryTier::SetBudget(size_t budget)
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_budget = budget;
+        EvictUntil(budget);
+    }
+
+    inline size_t MemoryTier::Budget() const
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        return m_budget;
+    }
+
+    inline size_t MemoryTier::Size() const
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        return m_size;
+    }
+
+    inline size_t MemoryTier::Count() const
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        return m_order.size();
+    }
+
+    inline void MemoryTier::EvictUntil(size_t size)
+    {
+        while (!m_order.empty() && m_size > size)
+        {
+            m_size -= m_order.back().second->size();
+            m_index.erase(m_order.back().first);
+            m_order.pop_back();
+        }
+    }
+
+    inline std::filesystem::path StagedOriginPath(const std::filesystem::path& staged)
+    {
+        std::filesystem::path origin = staged;
+        origin += ".origin";
+        return origin;
+    }
+
+    inline bool WriteStagedOrigin(const std::filesystem::path& staged, const std::filesystem::path& archive)
+    {
+        std::error_code sizeError, timeError;
+        uint64_t size = std::filesystem::file_size(staged, sizeError);
+        auto stamp = std::filesystem::last_write_time(staged, timeError);
+        if (sizeError || timeError) return false;
+
+        std::ofstream file(StagedOriginPath(staged), std::ios::trunc);
+        file << archive.lexically_normal().string() << '\n' << size << '\n' << (int64_t)stamp.time_since_epoch().count() << '\n';
+        file.close();
+        return !file.fail();
+    }
+
+    inline bool ReadStagedOrigin(const std::filesystem::path& staged, StagedOrigin& origin)
+    {
+        std::ifstream file(StagedOriginPath(staged));
+        std::string archive;
+        if (!std::getline(file, archive) || !(file >> origin.size >> origin.stamp) || archive.empty()) return false;
+        origin.archive = archive;
+
+        std::error_code sizeError, timeError;
+        uint64_t size = std::filesystem::file_size(staged, sizeError);
+        auto stamp = std::filesystem::last_write_time(staged, timeError);
+        return !sizeError && !timeError && size == origin.size && (int64_t)stamp.time_since_epoch().count() == origin.stamp;
+    }
+
+    inline MigrationQueue::~MigrationQueue()
+    {
+        // Joining Here Could Deadlock Under The Loader Lock
+        if (m_worker.joinable()) m_worker.detach();
+    }
+
+    inline std::string MigrationQueue::Key(const std::filesystem::path& archive)
+    {
+        std::string key = archive.lexically_normal().string();
+        for (auto& c : key) c = (char)::tolower((unsigned char)c);
+        return key;
+    }
+
+    inline void MigrationQueue::Enqueue(const std::filesystem::path& staged, const std::filesystem::path& archive)
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (m_stopping) return;
+
+        // Newer Write Of The Same Package Supersedes The Queued One
+        std::string key = Key(archive);
+        for (auto it = m_jobs.begin(); it != m_jobs.end();)
+            it = Key(it->archive) == key ? m_jobs.erase(it) : it + 1;
+
+        m_jobs.push_back(Job{ staged, archive });
+        if (!m_worker.joinable()) m_worker = std::thread(&MigrationQueue::Run, this);
+        m_wake.notify_one();
+    }
+
+    inline bool MigrationQueue::IsPending(const std::filesystem::path& archive) const
+    {
+        std::string key = Key(archive);
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (m_active == key) return true;
+        for (auto& job : m_jobs) if (Key(job.archive) == key) return true;
+        for (auto& job : m_failed) if (Key(job.archive) == key) return true;
+        return false;
+    }
+
+    inline void MigrationQueue::Cancel(const std::filesystem::path& archive)
+    {
+        std::string key = Key(archive);
+        std::unique_lock<std::mutex> guard(m_lock);
+        for (auto it = m_jobs.begin(); it != m_jobs.end();)
+            it = Key(it->archive) == key ? m_jobs.erase(it) : it + 1;
+        for (auto it = m_failed.begin(); it != m_failed.end();)
+            it = Key(it->archive) == key ? m_failed.erase(it) : it + 1;
+
+        // A Copy In Flight Is Allowed To Land, The Caller Deletes It Afterwards
+        m_idle.wait(guard, [&] { return m_active != key; });
+    }
+
+    inline size_t MigrationQueue::RetryFailed()
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        size_t retried = m_failed.size();
+        for (auto& job : m_failed) m_jobs.push_back(job);
+        m_failed.clear();
+        if (retried && !m_worker.joinable() && !m_stopping) m_worker = std::thread(&MigrationQueue::Run, this);
+        m_wake.notify_one();
+        return retried;
+    }
+
+    inline void MigrationQueue::Flush()
+    {
+        std::unique_lock<std::mutex> guard(m_lock);
+        if (!m_worker.joinable()) return;
+        m_idle.wait(guard, [&] { return m_jobs.empty() && m_active.empty(); });
+    }
+
+    inline void MigrationQueue::Stop()
+    {
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            m_stopping = true;
+        }
+        m_wake.notify_all();
+        if (m_worker.joinable()) m_worker.join();
+    }
+
+    inline void MigrationQueue::SetStagingRetention(size_t bytes)
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_retention = bytes;
+        PruneStaged();
+    }
+
+    inline MigrationQueue::Stats MigrationQueue::GetStats() const
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        Stats stats = m_stats;
+        stats.pending = m_jobs.size() + m_failed.size() + (m_active.empty() ? 0 : 1);
+        return stats;
+    }
+
+    inline void MigrationQueue::Run()
+    {
+        std::unique_lock<std::mutex> guard(m_lock);
+        for (;;)
+        {
+            // Pending Jobs Are Drained Before Stopping, Nothing Staged Is Lost
+            m_wake.wait(guard, [&] { return m_stopping || !m_jobs.empty(); });
+            if (m_jobs.empty()) return;
+
+            Job job = m_jobs.front();
+            m_jobs.pop_front();
+            m_active = Key(job.archive);
+
+            guard.unlock();
+            uint64_t bytes = 0;
+            bool migrated = Migrate(job, bytes);
+            guard.lock();
+
+            m_active.clear();
+            if (migrated)
+            {
+                m_stats.migrated++;
+                m_stats.migratedBytes += bytes;
+                for (auto it = m_migrated.begin(); it != m_migrated.end();)
+                {
+                    if (it->first != job.staged) { ++it; continue; }
+                    m_retained -= it->second;
+                    it = m_migrated.erase(it);
+                }
+                m_migrated.emplace_back(job.staged, bytes);
+                m_retained += bytes;
+                PruneStaged();
+            }
+            else
+            {
+                m_stats.failed++;
+                m_failed.push_back(job);
+            }
+            m_idle.notify_all();
+        }
+    }
+
+    inline bool MigrationQueue::Migrate(const Job& job, uint64_t& bytes)
+    {
+        std::error_code error;
+        std::filesystem::path partial = job.archive;
+        partial += ".part";
+
+        std::filesystem::create_directories(job.archive.parent_path(), error);
+        std::filesystem::copy_file(job.staged, partial, std::filesystem::copy_options::overwrite_existing, error);
+        if (error) { std::filesystem::remove(partial, error); return false; }
+
+        std::filesystem::rename(partial, job.archive, error);
+        if (error) { std::filesystem::remove(partial, error); return false; }
+
+        bytes = std::filesystem::file_size(job.archive, error);
+        return true;
+    }
+
+    inline void MigrationQueue::PruneStaged()
+    {
+        // Oldest Migrated Staged Copies Go First, Queued Ones Are Never Touched
+        while (m_retained > m_retention && !m_migrated.empty())
+        {
+            auto oldest = m_migrated.front();
+            m_migrated.pop_front();
+            m_retained -= oldest.second;
+
+            bool queued = false;
+            for (auto& job : m_jobs) if (job.staged == oldest.first) queued = true;
+            for (auto& job : m_failed) if (job.staged == oldest.first) queued = true;
+
+            std::error_code error;
+            if (queued) continue;
+            std::filesystem::remove(oldest.first, error);
+            std::filesystem::remove(StagedOriginPath(oldest.first), error);
+        }
+    }
+}
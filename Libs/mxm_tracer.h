@@ -0,0 +1,268 @@
+////////////////  Developed By Hamid.Memar (2023-Revised)  ////////////////
+///////////////   Licensed Under MIT Terms And Arguments   ////////////////
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Tracing
+{
+    // One complete span, names and categories must outlive the tracer (string literals)
+    struct TraceEvent
+    {
+        const char* name;
+        const char* category;
+        int64_t start;              // Nanoseconds since the tracer origin
+        int64_t duration;
+        std::string detail;         // Optional, exported as args.detail
+    };
+
+    // Process-wide span recorder. Every thread appends to its own buffer, so
+    // recording never contends; buffers are only locked together on export.
+    // Disabled tracing costs one relaxed atomic load per scope.
+    class Tracer
+    {
+    public:
+        Tracer() noexcept;
+
+        void Start(size_t capacity);
+
+        void Stop() noexcept;
+
+        bool IsEnabled() const noexcept;
+
+        void Clear();
+
+        int64_t Now() const noexcept;
+
+        void Record(const char* name, const char* category, int64_t start, int64_t end, std::string detail = std::string());
+
+        void SetThreadName(const char* name);
+
+        size_t EventCount() const noexcept;
+
+        size_t DroppedCount() const noexcept;
+
+        bool ExportChromeTrace(const std::filesystem::path& file) const;
+
+    private:
+        Tracer(const Tracer&) = delete;
+        Tracer& operator=(const Tracer&) = delete;
+
+        struct ThreadBuffer
+        {
+            uint32_t id;
+            std::string name;
+            std::mutex lock;
+            std::vector<TraceEvent> events;
+        };
+
+        ThreadBuffer& Local();
+
+        static void WriteEscaped(std::ostream& stream, const std::string& text);
+
+    private:
+        using clock = std::chrono::steady_clock;
+
+        mutable std::mutex m_lock;
+        std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;  // Kept for the process lifetime, threads are pooled
+        std::atomic<bool> m_enabled;
+        std::atomic<size_t> m_count;
+        std::atomic<size_t> m_dropped;
+        std::atomic<size_t> m_capacity;     // Read by recording threads while a restart may change it
+        clock::time_point m_origin;
+    };
+
+    // The tracer every scope reports to
+    Tracer& GlobalTracer();
+
+    // Records the lifetime of the scope when tracing is enabled
+    class TraceScope
+    {
+    public:
+        explicit TraceScope(const char* name, const char* category = "mxmesh") noexcept;
+
+        TraceScope(const char* name, const char* category, std::string detail);
+
+        ~TraceScope();
+
+    private:
+        TraceScope(const TraceScope&) = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+
+        const char* m_name;
+        const char* m_category;
+        int64_t m_start;
+        std::string m_detail;
+    };
+
+    inline Tracer::Tracer() noexcept
+        : m_enabled{ false }
+        , m_count{ 0 }
+        , m_dropped{ 0 }
+        , m_capacity{ 0 }
+        , m_origin{ clock::now() }
+    {}
+
+    inline Tracer& GlobalTracer()
+    {
+        static Tracer tracer;
+        return tracer;
+    }
+
+    inline void Tracer::Start(size_t capacity)
+    {
+        Clear();
+        m_capacity.store(capacity, std::memory_order_relaxed);
+        m_enabled.store(true, std::memory_order_release);
+    }
+
+    inline void Tracer::Stop() noexcept
+    {
+        m_enabled.store(false, std::memory_order_release);
+    }
+
+    inline bool Tracer::IsEnabled() const noexcept
+    {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    inline void Tracer::Clear()
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        for (auto& buffer : m_buffers)
+        {
+            std::lock_guard<std::mutex> bufferGuard(buffer->lock);
+            std::vector<TraceEvent>().swap(buffer->events);
+        }
+        m_count = 0;
+        m_dropped = 0;
+    }
+
+    inline int64_t Tracer::Now() const noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - m_origin).count();
+    }
+
+    inline Tracer::ThreadBuffer& Tracer::Local()
+    {
+        // Registered Once Per Thread, The Pointer Stays Valid For The Tracer Lifetime
+        thread_local ThreadBuffer* local = nullptr;
+        if (local) return *local;
+
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_buffers.push_back(std::make_unique<ThreadBuffer>());
+        local = m_buffers.back().get();
+        local->id = (uint32_t)m_buffers.size();
+        return *local;
+    }
+
+    inline void Tracer::Record(const char* name, const char* category, int64_t start, int64_t end, std::string detail)
+    {
+        if (!IsEnabled()) return;
+        size_t capacity = m_capacity.load(std::memory_order_relaxed);
+        if (capacity && m_count.fetch_add(1, std::memory_order_relaxed) >= capacity)
+        {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        if (!capacity) m_count.fetch_add(1, std::memory_order_relaxed);
+
+        ThreadBuffer& buffer = Local();
+        std::lock_guard<std::mutex> guard(buffer.lock);
+        buffer.events.push_back(TraceEvent{ name, category, start, end - start, std::move(detail) });
+    }
+
+    inline void Tracer::SetThreadName(const char* name)
+    {
+        ThreadBuffer& buffer = Local();
+        std::lock_guard<std::mutex> guard(buffer.lock);
+        buffer.name = name;
+    }
+
+    inline size_t Tracer::EventCount() const noexcept
+    {
+        return m_count.load(std::memory_order_relaxed) - m_dropped.load(std::memory_order_relaxed);
+    }
+
+    inline size_t Tracer::DroppedCount() const noexcept
+    {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+    inline void Tracer::WriteEscaped(std::ostream& stream, const std::string& text)
+    {
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\') stream << '\\' << c;
+            else if ((unsigned char)c < 0x20) { char code[8]; snprintf(code, sizeof code, "\\u%04x", (unsigned char)c); stream << code; }
+            else stream << c;
+        }
+    }
+
+    inline bool Tracer::ExportChromeTrace(const std::filesystem::path& file) const
+    {
+        std::ofstream stream(file, std::ios::binary | std::ios::trunc);
+        if (!stream) return false;
+
+        // Chrome Trace Event Format, Complete Events In Microseconds
+        stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        stream << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"MXMesh\"}}";
+
+        std::lock_guard<std::mutex> guard(m_lock);
+        char number[64];
+        for (auto& buffer : m_buffers)
+        {
+            std::lock_guard<std::mutex> bufferGuard(buffer->lock);
+            std::string threadName = buffer->name.empty() ? "thread " + std::to_string(buffer->id) : buffer->name;
+            stream << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->id << ",\"args\":{\"name\":\"";
+            WriteEscaped(stream, threadName);
+            stream << "\"}}";
+
+            for (auto& event : buffer->events)
+            {
+                stream << ",\n{\"name\":\"" << event.name << "\",\"cat\":\"" << event.category << "\",\"ph\":\"X\"";
+                snprintf(number, sizeof number, ",\"ts\":%.3f,\"dur\":%.3f", event.start / 1000.0, event.duration / 1000.0);
+                stream << number << ",\"pid\":1,\"tid\":" << buffer->id;
+                if (!event.detail.empty())
+                {
+                    stream << ",\"args\":{\"detail\":\"";
+                    WriteEscaped(stream, event.detail);
+                    stream << "\"}";
+                }
+                stream << "}";
+            }
+        }
+        stream << "\n]}\n";
+        return (bool)stream.flush();
+    }
+
+    inline TraceScope::TraceScope(const char* name, const char* category) noexcept
+        : m_name{ name }
+        , m_category{ category }
+        , m_start{ GlobalTracer().IsEnabled() ? GlobalTracer().Now() : -1 }
+    {}
+
+    inline TraceScope::TraceScope(const char* name, const char* category, std::string detail)
+        : m_name{ name }
+        , m_category{ category }
+        , m_start{ GlobalTracer().IsEnabled() ? GlobalTracer().Now() : -1 }
+        , m_detail{ m_start >= 0 ? std::move(detail) : std::string() }
+    {}
+
+    inline TraceScope::~TraceScope()
+    {
+        if (m_start < 0) return;
+        Tracer& tracer = GlobalTracer();
+        tracer.Record(m_name, m_category, m_start, tracer.Now(), std::move(m_detail));
+    }
+}
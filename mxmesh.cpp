@@ -28,6 +28,11 @@
 #include <fstream>
 #include <ppl.h>
 #include <sstream>
+#include <atomic>
+#include <future>
+#include <climits>
+#include <psapi.h>
+#pragma comment(lib,"psapi.lib")
 
 // Timestamp
 #include <chrono>
@@ -42,11 +47,71 @@
 // Stopwatch
 #include "mxm_stopwatch.h"
 
+// Memory Streams
+#include "mxm_memstream.h"
+
+// Copy Kernels
+#include "mxm_copykernels.h"
+
+// Buffer Pool
+#include "mxm_bufferpool.h"
+
+// Checkpoint Catalog
+#include "mxm_catalog.h"
+
+// Tiered Storage
+#include "mxm_tiers.h"
+
+// Memory Checkpoints
+#include "mxm_snapshots.h"
+
+// Shared Clipboard
+#include "mxm_clipboard.h"
+
+// Memory Ledger
+#include "mxm_memledger.h"
+
+// Animated Caches
+#include "mxm_animcache.h"
+
+// Temporal Codecs
+#include "mxm_temporal.h"
+
+// Mesh Simplification
+#include "mxm_simplify.h"
+
+// Locality Reordering
+#include "mxm_reorder.h"
+
+// Animated Playback
+#include "mxm_playback.h"
+
+// Operation Statistics
+#include "mxm_opstats.h"
+
+// Tracing
+#include "mxm_tracer.h"
+
 // Namespaces
 using namespace std;
 using namespace zipper;
 using namespace concurrency;
 using namespace PerformanceTools;
+using namespace MemoryStreams;
+using namespace CopyKernels;
+using namespace BufferPools;
+using namespace Catalogs;
+using namespace TieredStorage;
+using namespace Snapshots;
+using namespace SharedClipboards;
+using namespace MemoryLedgers;
+using namespace AnimatedCaches;
+using namespace TemporalCodecs;
+using namespace Simplification;
+using namespace Reordering;
+using namespace Playback;
+using namespace OperationStats;
+using namespace Tracing;
 using namespace filesystem;
 
 // Pre-Defined Macros
@@ -57,37 +122,123 @@ using namespace filesystem;
 // Utility Macros
 #define MaxMeshMXS(fn, name) Value* fn##_api(Value**,int); Primitive fn##_pf (_M(name), _M(PLUGIN_MXS_STRUCT), fn##_api)
 #define SINGLE_THREAD_LOOP_BEGIN(lsize)	for (size_t i = 0; i < lsize; i++) {
-#define MULTI_THREAD_LOOP_BEGIN(lsize) parallel_for(size_t(0), (size_t)lsize, [&](size_t i) {
+#define MULTI_THREAD_LOOP_BEGIN(lsize) TracedChunks((size_t)(lsize), BalancedGrain((size_t)(lsize)), [&](size_t i) {
 #define SINGLE_THREAD_LOOP_END }
 #define MULTI_THREAD_LOOP_END });
 #define BUFFER std::vector<unsigned char>
-#define BUFFER_FREE(buffer) BUFFER().swap(buffer)
+#define BUFFER_FREE(buffer) ReleaseStaging(buffer)
+#define TOPOLOGY_HASH_CHUNK 65536
 
 // Logger Macros
-#define DebugLog(fmt,...) if(DebugMode) { mprintf(L"[MXMesh] : " fmt L"\n",__VA_ARGS__); }
+#define DebugLog(fmt,...) if(DebugMode && this_thread::get_id() == mainThreadId) { mprintf(L"[MXMesh] : " fmt L"\n",__VA_ARGS__); }
 
 // Option Macros
 #define DISK_CACHE_BUFFERING_MODE					0xF0
 #define MEMORY_CACHE_BUFFERING_MODE					0xED
 #define RESTORE_CACHE_MODE_SINGLE_THREAD			0xCA
 #define RESTORE_CACHE_MODE_MULTI_THREAD				0xBE
+#define RESTORE_CACHE_MODE_AUTO						0xAA
+#define CACHE_TOPOLOGY_MODE_TRI						0x00
+#define CACHE_TOPOLOGY_MODE_POLY					0xB0
+#define RESTORE_TARGET_EDITABLE_POLY				0xE1
+#define RESTORE_TARGET_EDITABLE_MESH				0xE2
+#define MEMORY_CHECKPOINT_RAW						0xD0
+#define MEMORY_CHECKPOINT_COMPRESSED				0xD1
+#define UNDO_MODE_FULL								0xF0
+#define UNDO_MODE_COMPACT							0xF1
+
+// Package Macros
+#define MXM_PACKAGE_VERSION							5
+#define LEGACY_META_DATA_SIZE						offsetof(MaxMeshMetaData, version)
+#define CATALOG_FILE_NAME							"mxmesh.catalog"
+#define MEMORY_PACKAGE_PREFIX						"memory:"
+#define CLIPBOARD_PACKAGE_NAME						"clipboard:"
+#define CLIPBOARD_SHARED_NAME						L"Local\\MXMeshClipboard"
+#define LOD_ENTRY_PREFIX							"max-mesh.lod"
+#define MAX_LOD_LEVELS								4
+#define CHUNK_ENTRY_PREFIX							"max-mesh.chk"
+#define CHUNK_INDEX_ENTRY							"max-mesh.chi"
+#define CHUNK_VERTEX_ENTRY							"max-mesh.cvi"
+#define CHUNK_MAP_ENTRY								"max-mesh.cti"
+#define CHUNK_NORMAL_ENTRY							"max-mesh.cni"
+#define MAX_CHUNK_CELLS								1024
+
+// Sweep Macros
+#define CACHE_SWEEP_INTERVAL						2000
+#define CACHE_SWEEP_VALIDATE_BATCH					256
+#define CACHE_SWEEP_EVICT_BATCH						16
+
+// Channel Selection Macros
+#define RESTORE_CHANNEL_GEOMETRY					0x01
+#define RESTORE_CHANNEL_UVS							0x02
+#define RESTORE_CHANNEL_NORMALS						0x04
+#define RESTORE_CHANNEL_ALL							0x07
+
+// Progressive Restore Macros
+#define PROGRESSIVE_POLL_INTERVAL					50
+
+// Storage Tier Macros
+#define STORAGE_TIER_MEMORY							0
+#define STORAGE_TIER_STAGING						1
+#define STORAGE_TIER_ARCHIVE						2
+#define STORAGE_TIER_SNAPSHOT						3
+#define STORAGE_TIER_CLIPBOARD						4
 
 // Global Instances
 HINSTANCE			hInstance;
 Interface*			maxInterface;
 Stopwatch			profiler;
 fstream				fileWritter;
+BufferPool			bufferPool			(256u << 20);
+Catalog				catalog;
+file_time_type		catalogFolderStamp;
+bool				catalogDirty		= false;
+UINT_PTR			cacheSweepTimer		= 0;
+size_t				cacheSweepCursor	= 0;
+MemoryTier			memoryTier			(0);
+MigrationQueue		migrationQueue;
+UINT64				tierReads[5]		= {};
+SnapshotRing		memoryCheckpoints	(512u << 20, 8);
+SharedClipboard		sharedClipboard		(CLIPBOARD_SHARED_NAME);
+MemoryLedger		memoryLedger;
+StatsRecorder		opStats;
+SharedPackage		clipboardPackage;
+uint64_t			clipboardGeneration	= 0;
 
 // Global Values
 Class_ID			triobjectCID		(TRIOBJ_CLASS_ID, 0);
 string				cachePath			= "C:\\Users\\Public";
+string				stagingPath			= "";
 Zipper::zipFlags	compressionMode		= Zipper::Better;
 BYTE				cacheBufferingMode	= MEMORY_CACHE_BUFFERING_MODE;
-BYTE				restoreMode			= RESTORE_CACHE_MODE_MULTI_THREAD;
+BYTE				restoreMode			= RESTORE_CACHE_MODE_AUTO;
+BYTE				cacheTopologyMode	= CACHE_TOPOLOGY_MODE_POLY;
+BYTE				restoreTarget		= RESTORE_TARGET_EDITABLE_POLY;
+size_t				restoreMemoryLimit	= 0;
+BYTE				memoryCheckpointMode = MEMORY_CHECKPOINT_RAW;
+BYTE				undoMode			= UNDO_MODE_COMPACT;
+size_t				playbackRingFrames	= 32;
+size_t				playbackLookahead	= 8;
+CodecSettings		animationCodec		= DefaultCodecSettings;
+int					cacheLodLevels		= 0;
+float				cacheLodRatio		= 0.25f;
+int					cacheChunkCells		= 0;
+bool				cacheReorder		= false;
+Calibration			copyCalibration		= DefaultCalibration;
+bool				copyCalibrated		= false;
 bool				DebugMode			= false;
+thread::id			mainThreadId		= this_thread::get_id();
 
-// Global Buffers
-stringstream vtxBuffer, nrmBuffer, texBuffer, idxBuffer, tdxBuffer, ndxBuffer, mtaBuffer;
+// Traced Parallel Loops
+template<typename Body> void TracedChunks(size_t count, size_t grain, const Body& body)
+{
+	// One Span Per Chunk, Shows Where Workers Idle
+	ParallelRanges(count, grain, [&](size_t begin, size_t end)
+	{
+		TraceScope trace("chunk", "worker");
+		for (size_t i = begin; i < end; i++) body(i);
+	});
+}
 
 // Structures
 struct MaxMeshMetaData
@@ -99,6 +250,58 @@ struct MaxMeshMetaData
 	AffineParts affine;
 	Matrix3 tm;
 	DWORD col;
+
+	// Extended Header, Zeroed On Legacy Packages
+	UINT32 version;
+	UINT32 topology;
+	int cNum;
+	UINT64 topologyHash;
+	Box3 bounds;	// Version 4 And Later
+	UINT64 layoutHash;	// Version 5 And Later
+};
+struct MaxMeshPolyFace
+{
+	DWORD smGroup;
+	MtlID material;
+	UINT16 flags;
+};
+struct MaxMeshChunk
+{
+	UINT64 key;			// Morton Code Of The Cell
+	Box3 bounds;
+	int vNum, fNum, cNum, tNum, nNum;
+	UINT64 rawSize;
+};
+struct MeshChannelView
+{
+	const char* entry;
+	const void* data;
+	size_t size;
+};
+struct MeshCapture
+{
+	MaxMeshMetaData meta;
+	Mesh triMesh;
+	MNMesh polyMesh;
+	Object* converted = nullptr;
+	vector<Point3> points, normals;
+	vector<int> degrees, corners, mapCorners, normalCorners;
+	vector<MaxMeshPolyFace> faces;
+	vector<BYTE> normalFlags, cornerFlags;
+	vector<MeshChannelView> channels;
+	vector<UVVert> mapVerts;	// Owned Copy When The Capture Outlives Its Source Mesh
+	vector<Package> lodPackages;	// Nested Single Level Packages, Coarser With Every Level
+	vector<Package> chunkPackages;	// Self Contained Deflated Packages, One Per Occupied Cell
+	vector<string> chunkEntries;
+	vector<MaxMeshChunk> chunkIndex;
+	bool reorder = false;			// Locality Order, Only For Packages Nothing Else Indexes Into
+
+	~MeshCapture() { if (converted) converted->DeleteMe(); }
+
+	template<typename T> void AddChannel(const char* entry, const T* data, size_t count)
+	{
+		channels.push_back({ entry, data, count * sizeof(T) });
+	}
 };
 
 // Timestamp Utilities
@@ -155,701 +358,4687 @@ const wchar_t* StringGetWideChar(const char* c)
 }
 
 // Forward Definitions
-bool GenerateNewPolyFromCache(const wchar_t* mxm_package, INode* node);
+bool GenerateNewPolyFromCache(const wchar_t* mxm_package, INode* node, int lod = 0, BYTE channels = RESTORE_CHANNEL_ALL);
+bool IsMemoryGranted(const ScopedCharge& charge, const wchar_t* purpose);
+void CatalogPackage(const MeshCapture& capture, const char* packagePath, const path& writtenPath);
+void TouchCatalogPackage(const wchar_t* packagePath);
 
 // Undo/Redo System
 class RestoreMeshOp : public RestoreObj
 {
 public:
-	RestoreMeshOp(PolyObject* poly, const wchar_t* mxo_package, INode* node)
-	{
-		obj = poly;
-		this->undo_mnMesh = MNMesh(poly->mm);
-		redo_mxo_package = mxo_package;
-		redo_node = node;
-	}
+	RestoreMeshOp(PolyObject* poly, const wchar_t* mxo_package, shared_ptr<const vector<BYTE>> redo_memory, BYTE redo_channels = RESTORE_CHANNEL_ALL);
 	~RestoreMeshOp()
 	{
 		undo_mnMesh.ClearAndFree();
 	}
+	void Restore(int isUndo);
+	void Redo();
+	int Size();
+	bool Accounted() const { return undo_charge.Granted(); }
+private:
+	PolyObject*		obj;
+	ScopedCharge	undo_charge		{ memoryLedger, LedgerUndo };
+	MNMesh			undo_mnMesh;	// Full Copy, Only When The Package Can't Carry The Mesh
+	shared_future<shared_ptr<vector<BYTE>>> undo_package;
+	vector<DWORD>	undo_vertFlags, undo_faceFlags;
+	vector<pair<UINT64, DWORD>> undo_edgeFlags;	// Keyed By Both Collapsed Vertex Ids
+	size_t			undo_rawSize = 0;
+	size_t FlagBytes() const { return (undo_vertFlags.size() + undo_faceFlags.size()) * sizeof(DWORD) + undo_edgeFlags.size() * sizeof(pair<UINT64, DWORD>); }
+	wstring			redo_mxo_package;
+	shared_ptr<const vector<BYTE>> redo_memory;
+	BYTE			redo_channels;
+};
+
+class RestoreVertsOp : public RestoreObj
+{
+public:
+	RestoreVertsOp(PolyObject* poly, bool withNormals)
+	{
+		obj = poly;
+		Capture(undo_points, undo_normals, withNormals);
+		undo_charge.Resize(Size());
+	}
 	void Restore(int isUndo)
 	{
-		obj->mm.ClearAndFree();
-		obj->mm = this->undo_mnMesh;
-		obj->NotifyDependents(FOREVER, ALL_CHANNELS, REFMSG_CHANGE);
+		if (isUndo) Capture(redo_points, redo_normals, !undo_normals.empty());
+		undo_charge.Resize(Size());
+		Apply(undo_points, undo_normals);
 	}
 	void Redo()
 	{
-		GenerateNewPolyFromCache(redo_mxo_package, redo_node);
+		Apply(redo_points, redo_normals);
+	}
+	int Size()
+	{
+		return (int)((undo_points.size() + redo_points.size() + undo_normals.size() + redo_normals.size()) * sizeof(Point3));
+	}
+	bool Accounted() const { return undo_charge.Granted(); }
+private:
+	void Capture(vector<Point3>& points, vector<Point3>& normals, bool withNormals)
+	{
+		MNMesh& mesh = obj->GetMesh();
+		MNNormalSpec* mesh_ns = mesh.GetSpecifiedNormals();
+		points.resize(mesh.numv);
+		MULTI_THREAD_LOOP_BEGIN(mesh.numv)
+		points[i] = mesh.v[i].p;
+		MULTI_THREAD_LOOP_END
+		if (withNormals && mesh_ns)
+		{
+			normals.resize(mesh_ns->GetNumNormals());
+			for (int i = 0; i < mesh_ns->GetNumNormals(); i++) normals[i] = mesh_ns->Normal(i);
+		}
+	}
+	void Apply(const vector<Point3>& points, const vector<Point3>& normals)
+	{
+		MNMesh& mesh = obj->GetMesh();
+		MNNormalSpec* mesh_ns = mesh.GetSpecifiedNormals();
+		if (points.size() != (size_t)mesh.numv) return;
+		MULTI_THREAD_LOOP_BEGIN(points.size())
+		mesh.v[i].p = points[i];
+		MULTI_THREAD_LOOP_END
+		if (mesh_ns && normals.size() == (size_t)mesh_ns->GetNumNormals())
+			for (int i = 0; i < mesh_ns->GetNumNormals(); i++) mesh_ns->Normal(i) = normals[i];
+		mesh.InvalidateGeomCache();
+		obj->NotifyDependents(FOREVER, PART_GEOM, REFMSG_CHANGE);
 	}
 private:
 	PolyObject*		obj;
-	MNMesh			undo_mnMesh;
-	const wchar_t*	redo_mxo_package;
-	INode*			redo_node;
+	ScopedCharge	undo_charge		{ memoryLedger, LedgerUndo };
+	vector<Point3>	undo_points, undo_normals;
+	vector<Point3>	redo_points, redo_normals;
 };
 
-// Operations
-INode* CreateObjectInScene(SClass_ID sid, Class_ID cid)
+// Topology Fingerprint
+UINT64 HashValue(UINT64 hash, UINT64 value)
 {
-	Object* obj = static_cast<Object*>(CreateInstance(sid, cid));
-	return maxInterface->CreateObjectNode(obj);
+	// FNV-1a Over 64-bit Words
+	hash ^= value;
+	return hash * 0x100000001B3ull;
 }
-bool CacheMeshToDisk(INode* node, bool checkpoint = false)
+template<typename FaceHasher> UINT64 HashFaces(UINT64 hash, int fNum, const FaceHasher& hashFace)
 {
-	char outputNameBuffer[MAX_PATH];
-
-	if (!node) { return false; }
-	DebugLog(L"Caching object [%s] mesh buffer...", node->GetName());
-
-	if (cacheBufferingMode == DISK_CACHE_BUFFERING_MODE)
-		DebugLog(L"Config `Cache Buffering Mode` = DISK_CACHE_BUFFERING_MODE");
-	if (cacheBufferingMode == MEMORY_CACHE_BUFFERING_MODE)
-		DebugLog(L"Config `Cache Buffering Mode` = MEMORY_CACHE_BUFFERING_MODE");
-
-	profiler.Reset(); profiler.Start();
+	// Fixed Chunks Combined In Order, Identical Result For Any Thread Count
+	size_t chunks = ((size_t)fNum + TOPOLOGY_HASH_CHUNK - 1) / TOPOLOGY_HASH_CHUNK;
+	vector<UINT64> chunkHashes(chunks);
+	MULTI_THREAD_LOOP_BEGIN(chunks)
+	UINT64 chunkHash = 0xCBF29CE484222325ull;
+	size_t end = min((size_t)fNum, (i + 1) * TOPOLOGY_HASH_CHUNK);
+	for (size_t f = i * TOPOLOGY_HASH_CHUNK; f < end; f++) chunkHash = hashFace(chunkHash, f);
+	chunkHashes[i] = chunkHash;
+	MULTI_THREAD_LOOP_END
 
-	TimeValue t = GetCOREInterface()->GetTime();
-	Object* obj = node->EvalWorldState(t).obj;
-
-	if (obj->CanConvertToType(triobjectCID))
+	for (UINT64 chunkHash : chunkHashes) hash = HashValue(hash, chunkHash);
+	return hash ? hash : 1;
+}
+template<typename FaceAccessor> UINT64 HashTopology(int vNum, int fNum, const FaceAccessor& face)
+{
+	return HashFaces(HashValue(HashValue(0xCBF29CE484222325ull, (UINT64)vNum), (UINT64)fNum), fNum, [&](UINT64 hash, size_t f)
 	{
-		// Get Tri Object
-		TriObject* tobj = (TriObject*)obj->ConvertToType(t, triobjectCID); if (!tobj) { return false; }
+		int deg; const int* vtx;
+		face(f, deg, vtx);
+		hash = HashValue(hash, (UINT64)deg);
+		for (int j = 0; j < deg; j++) hash = HashValue(hash, (UINT64)(UINT32)vtx[j]);
+		return hash;
+	});
+}
+UINT64 HashTopology(MNMesh& mesh)
+{
+	// Dead Elements Shift Indices On Capture, No Fingerprint
+	for (int i = 0; i < mesh.numv; i++) if (mesh.v[i].GetFlag(MN_DEAD)) return 0;
+	for (int i = 0; i < mesh.numf; i++) if (mesh.f[i].GetFlag(MN_DEAD)) return 0;
 
-		// Get Mesh
-		Mesh mesh = tobj->GetMesh();
+	return HashTopology(mesh.numv, mesh.numf, [&](size_t i, int& deg, const int*& vtx) {
+		deg = mesh.f[i].deg;
+		vtx = mesh.f[i].vtx;
+	});
+}
 
-		// Compute Normals
-		mesh.SpecifyNormals();
-		MeshNormalSpec* mesh_ns = mesh.GetSpecifiedNormals();
-		mesh_ns->CheckNormals();
+// Layout Fingerprint, Everything a Vertex Only Restore Leaves Untouched
+template<typename FaceAccessor> UINT64 HashLayout(int tNum, int nNum, int fNum, const FaceAccessor& face)
+{
+	// Smoothing Groups, Material Ids, Texture & Normal Corners Face By Face
+	return HashFaces(HashValue(HashValue(0xCBF29CE484222325ull, (UINT64)tNum), (UINT64)nNum), fNum, face);
+}
+UINT64 HashLayout(MNMesh& mesh)
+{
+	MNMap* map = mesh.MNum() > 1 ? mesh.M(1) : nullptr;
+	if (map && (map->GetFlag(MN_DEAD) || map->numf != mesh.numf)) map = nullptr;
+	MNNormalSpec* mesh_ns = mesh.GetSpecifiedNormals();
+	if (mesh_ns && mesh_ns->GetNumFaces() != mesh.numf) mesh_ns = nullptr;
 
-		// Get Mesh Data Sizes
-		int vNum = mesh.numVerts;
-		int nNum = mesh_ns->GetNumNormals();
-		int fNum = mesh.numFaces;
-		int tNum = mesh.numTVerts;
+	return HashLayout(map ? map->numv : 0, mesh_ns ? mesh_ns->GetNumNormals() : 0, mesh.numf, [&](UINT64 hash, size_t i)
+	{
+		const MNFace& face = mesh.f[i];
+		hash = HashValue(HashValue(hash, (UINT64)face.smGroup), (UINT64)face.material);
+		if (map) for (int j = 0; j < face.deg; j++) hash = HashValue(hash, (UINT64)(UINT32)map->f[i].tv[j]);
+		if (mesh_ns)
+		{
+			MNNormalFace& normalFace = mesh_ns->Face((int)i);
+			for (int j = 0; j < face.deg; j++) hash = HashValue(HashValue(hash, (UINT64)(UINT32)normalFace.GetNormalID(j)), normalFace.GetSpecified(j) ? 1 : 0);
+		}
+		return hash;
+	});
+}
 
-		MaxMeshMetaData meshMeta;
-		meshMeta.vNum = vNum;
-		meshMeta.nNum = nNum;
-		meshMeta.fNum = fNum;
-		meshMeta.tNum = tNum;
-
-		// Dump Information
-		sprintf_s(meshMeta.name, sizeof meshMeta.name, "%S", node->GetName());
-		meshMeta.col = node->GetWireColor();
-
-		// Dump Transformations
-		meshMeta.tm = node->GetObjTMAfterWSM(t);
-		decomp_affine(meshMeta.tm, &meshMeta.affine);
-		QuatToEuler(meshMeta.affine.q, meshMeta.rot);
-		meshMeta.pos.x = meshMeta.affine.t.x;
-		meshMeta.pos.y = meshMeta.affine.t.y;
-		meshMeta.pos.z = meshMeta.affine.t.z;
-		meshMeta.rot.x = RadToDeg_float(meshMeta.rot.x);
-		meshMeta.rot.y = RadToDeg_float(meshMeta.rot.y);
-		meshMeta.rot.z = RadToDeg_float(meshMeta.rot.z);
-		meshMeta.scale.x = meshMeta.affine.k.x;
-		meshMeta.scale.y = meshMeta.affine.k.y;
-		meshMeta.scale.z = meshMeta.affine.k.z;
-
-		// Get Temp Path
-		string tempAddr = filesystem::temp_directory_path().string();
-
-		// Dump Raw Buffers
-		if (cacheBufferingMode == DISK_CACHE_BUFFERING_MODE)
-		{
-			fileWritter.open(tempAddr + "\\max-mesh.vtx", ios::binary | ios::out);
-			fileWritter.write((char*)mesh.verts, vNum * sizeof(Point3));
-			fileWritter.close();
+// Operations
+path CalibrationFilePath()
+{
+	return filesystem::temp_directory_path() / "MXMeshCalibration.bin";
+}
+void SaveCalibration()
+{
+	ofstream file(CalibrationFilePath(), ios::binary | ios::trunc);
+	file.write((const char*)&copyCalibration, sizeof(Calibration));
+}
+void LoadCalibration()
+{
+	Calibration loaded;
+	ifstream file(CalibrationFilePath(), ios::binary);
+	if (file.read((char*)&loaded, sizeof(Calibration)) && loaded.grainSize) { copyCalibration = loaded; copyCalibrated = true; }
+}
+void EnsureCalibration()
+{
+	// Measured Once Per Machine On The First Restore, Defaults Only Cover A Failed Sweep
+	if (copyCalibrated || this_thread::get_id() != mainThreadId) return;
+	copyCalibrated = true;
 
-			fileWritter.open(tempAddr + "\\max-mesh.tex", ios::binary | ios::out);
-			fileWritter.write((char*)mesh.tVerts, tNum * sizeof(UVVert));
-			fileWritter.close();
+	DebugLog(L"No restore calibration found, measuring copy kernels once...");
+	try
+	{
+		vector<Sample> samples;
+		copyCalibration = Calibrate(samples);
+		SaveCalibration();
+	}
+	catch (const bad_alloc&)
+	{
+		DebugLog(L"Calibration skipped, not enough memory for the sweep, using defaults.");
+	}
+}
+bool IsParallelRestore(size_t bytes)
+{
+	if (restoreMode == RESTORE_CACHE_MODE_SINGLE_THREAD) return false;
+	if (restoreMode == RESTORE_CACHE_MODE_MULTI_THREAD) return true;
+	return bytes >= copyCalibration.parallelThreshold;
+}
+template<typename Body> void RestoreLoop(size_t count, size_t bytes, const Body& body)
+{
+	if (!IsParallelRestore(bytes))
+	{
+		SINGLE_THREAD_LOOP_BEGIN(count)
+		body(i);
+		SINGLE_THREAD_LOOP_END
+	}
+	else
+	{
+		MULTI_THREAD_LOOP_BEGIN(count)
+		body(i);
+		MULTI_THREAD_LOOP_END
+	}
+}
 
-			fileWritter.open(tempAddr + "\\max-mesh.idx", ios::binary | ios::out);
-			fileWritter.write((char*)mesh.faces, fNum * sizeof(Face));
-			fileWritter.close();
+// Operation Statistics
+string StatsTarget(INode* node)
+{
+	char target[128];
+	sprintf_s(target, sizeof target, "%S", node->GetName());
+	return target;
+}
+double ElapsedMilliseconds(chrono::steady_clock::time_point start)
+{
+	return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+void RecordPackageStats(Unzipper& unzipper)
+{
+	// Entry Sizes From The Central Directory, Nothing Is Inflated
+	if (!opStats.IsRecording()) return;
+	uint64_t rawBytes = 0, packageBytes = 0;
+	for (auto& entry : unzipper.entries())
+	{
+		opStats.AddChannel(entry.name.c_str(), entry.uncompressedSize, entry.compressedSize, 0);
+		rawBytes += entry.uncompressedSize;
+		packageBytes += entry.compressedSize;
+	}
+	opStats.AddBytes(rawBytes, packageBytes);
+}
+void RecordPackageStats(const vector<BYTE>& package)
+{
+	if (!opStats.IsRecording()) return;
+	RegionInStream stream(package.data(), package.size());
+	Unzipper unzipper(stream);
+	RecordPackageStats(unzipper);
+	unzipper.close();
+}
+void RecordPackageStats(const path& package)
+{
+	if (!opStats.IsRecording()) return;
+	Unzipper unzipper(package.string());
+	RecordPackageStats(unzipper);
+	unzipper.close();
+}
 
-			fileWritter.open(tempAddr + "\\max-mesh.tdx", ios::binary | ios::out);
-			fileWritter.write((char*)mesh.tvFace, fNum * sizeof(TVFace));
-			fileWritter.close();
+// Capture Pipeline
+void CaptureMeta(INode* node, TimeValue t, MaxMeshMetaData& meshMeta)
+{
+	memset(&meshMeta, 0, sizeof(MaxMeshMetaData));
+	meshMeta.version = MXM_PACKAGE_VERSION;
 
-			fileWritter.open(tempAddr + "\\max-mesh.ndx", ios::binary | ios::out);
-			fileWritter.write((char*)mesh_ns->GetFaceArray(), fNum * sizeof(MeshNormalFace));
-			fileWritter.close();
+	// Dump Information
+	sprintf_s(meshMeta.name, sizeof meshMeta.name, "%S", node->GetName());
+	meshMeta.col = node->GetWireColor();
 
-			fileWritter.open(tempAddr + "\\max-mesh.nrm", ios::binary | ios::out);
-			fileWritter.write((char*)mesh_ns->GetNormalArray(), nNum * sizeof(Point3));
-			fileWritter.close();
+	// Dump Transformations
+	meshMeta.tm = node->GetObjTMAfterWSM(t);
+	decomp_affine(meshMeta.tm, &meshMeta.affine);
+	QuatToEuler(meshMeta.affine.q, meshMeta.rot);
+	meshMeta.pos.x = meshMeta.affine.t.x;
+	meshMeta.pos.y = meshMeta.affine.t.y;
+	meshMeta.pos.z = meshMeta.affine.t.z;
+	meshMeta.rot.x = RadToDeg_float(meshMeta.rot.x);
+	meshMeta.rot.y = RadToDeg_float(meshMeta.rot.y);
+	meshMeta.rot.z = RadToDeg_float(meshMeta.rot.z);
+	meshMeta.scale.x = meshMeta.affine.k.x;
+	meshMeta.scale.y = meshMeta.affine.k.y;
+	meshMeta.scale.z = meshMeta.affine.k.z;
+}
+void ReorderTriCapture(MeshCapture& capture)
+{
+	ScopedStage stage(opStats, "reorder");
+	Mesh& mesh = capture.triMesh;
+	MaxMeshMetaData& meshMeta = capture.meta;
+	size_t vNum = meshMeta.vNum, fNum = meshMeta.fNum, tNum = meshMeta.tNum, nNum = meshMeta.nNum;
+	MeshNormalSpec* mesh_ns = mesh.GetSpecifiedNormals();
 
-			fileWritter.open(tempAddr + "\\max-mesh.mta", ios::binary | ios::out);
-			fileWritter.write((char*)&meshMeta, sizeof(MaxMeshMetaData));
-			fileWritter.close();
-		}
-		if (cacheBufferingMode == MEMORY_CACHE_BUFFERING_MODE)
-		{
-			vtxBuffer = stringstream(string(reinterpret_cast<char*>((char*)mesh.verts), vNum * sizeof(Point3)));
-			nrmBuffer = stringstream(string(reinterpret_cast<char*>((char*)mesh_ns->GetNormalArray()), nNum * sizeof(Point3)));
-			texBuffer = stringstream(string(reinterpret_cast<char*>((char*)mesh.tVerts), tNum * sizeof(UVVert)));
-			idxBuffer = stringstream(string(reinterpret_cast<char*>((char*)mesh.faces), fNum * sizeof(Face)));
-			tdxBuffer = stringstream(string(reinterpret_cast<char*>((char*)mesh.tvFace), fNum * sizeof(TVFace)));
-			ndxBuffer = stringstream(string(reinterpret_cast<char*>((char*)mesh_ns->GetFaceArray()), fNum * sizeof(MeshNormalFace)));
-			mtaBuffer = stringstream(string(reinterpret_cast<char*>((char*)&meshMeta), sizeof(MaxMeshMetaData)));
-		}
+	// Arrays Belong To The Captured Copy, Permuted In Place Through Working Copies
+	ScopedCharge reorderCharge(memoryLedger, LedgerStaging, vNum * (sizeof(Point3) + 2 * sizeof(int)) +
+		fNum * (sizeof(Face) + sizeof(TVFace) + sizeof(MeshNormalFace) + 5 * sizeof(int)) + tNum * (sizeof(UVVert) + sizeof(int)) + nNum * (sizeof(Point3) + sizeof(int)));
+	if (!IsMemoryGranted(reorderCharge, L"locality reorder")) return;
 
-		// Packaging
-		sprintf_s(outputNameBuffer, sizeof outputNameBuffer, "%s\\%S.mxo", cachePath.c_str(), node->GetName());
-		if (checkpoint) sprintf_s(outputNameBuffer, sizeof outputNameBuffer, "%s\\%S-%s.mxo", cachePath.c_str(), node->GetName(), gtfrmtt());
+	// Vertices Along a Space Filling Curve
+	vector<int> vertexOrder = SpatialOrder((const Position*)mesh.verts, vNum);
+	vector<int> vertexRemap = InvertOrder(vertexOrder);
+	vector<Point3> points(mesh.verts, mesh.verts + vNum);
+	MULTI_THREAD_LOOP_BEGIN(vNum)
+	mesh.verts[i] = points[vertexOrder[i]];
+	MULTI_THREAD_LOOP_END
 
-		// Remove Package If Exists
-		std::remove(outputNameBuffer);
+	// Faces In Vertex Cache Order
+	vector<int> degrees(fNum, 3), corners(fNum * 3);
+	MULTI_THREAD_LOOP_BEGIN(fNum)
+	for (int j = 0; j < 3; j++) corners[i * 3 + j] = vertexRemap[mesh.faces[i].v[j]];
+	MULTI_THREAD_LOOP_END
+	vector<int> faceOrder = CacheOrder(degrees.data(), corners.data(), fNum, vNum);
+	vector<Face> faces(mesh.faces, mesh.faces + fNum);
+	MULTI_THREAD_LOOP_BEGIN(fNum)
+	mesh.faces[i] = faces[faceOrder[i]];
+	for (int j = 0; j < 3; j++) mesh.faces[i].v[j] = (DWORD)corners[faceOrder[i] * 3 + j];
+	MULTI_THREAD_LOOP_END
 
-		// Compressing
-		Zipper zipper(_strlwr(outputNameBuffer));
-		if (cacheBufferingMode == DISK_CACHE_BUFFERING_MODE)
-		{
-			zipper.add(tempAddr + "\\max-mesh.vtx", compressionMode);
-			zipper.add(tempAddr + "\\max-mesh.nrm", compressionMode);
-			zipper.add(tempAddr + "\\max-mesh.tex", compressionMode);
-			zipper.add(tempAddr + "\\max-mesh.idx", compressionMode);
-			zipper.add(tempAddr + "\\max-mesh.tdx", compressionMode);
-			zipper.add(tempAddr + "\\max-mesh.ndx", compressionMode);
-			zipper.add(tempAddr + "\\max-mesh.mta", compressionMode);
-		}
-		if (cacheBufferingMode == MEMORY_CACHE_BUFFERING_MODE)
-		{
-			zipper.add(vtxBuffer, "max-mesh.vtx", compressionMode);
-			zipper.add(nrmBuffer, "max-mesh.nrm", compressionMode);
-			zipper.add(texBuffer, "max-mesh.tex", compressionMode);
-			zipper.add(idxBuffer, "max-mesh.idx", compressionMode);
-			zipper.add(tdxBuffer, "max-mesh.tdx", compressionMode);
-			zipper.add(ndxBuffer, "max-mesh.ndx", compressionMode);
-			zipper.add(mtaBuffer, "max-mesh.mta", compressionMode);
-		}
-		zipper.close();
+	// Texture Vertices In Order Of First Use
+	if (tNum && mesh.tvFace)
+	{
+		vector<TVFace> mapFaces(mesh.tvFace, mesh.tvFace + fNum);
+		vector<int> mapCorners(fNum * 3);
+		for (size_t i = 0; i < fNum; i++)
+			for (int j = 0; j < 3; j++) mapCorners[i * 3 + j] = (int)mapFaces[faceOrder[i]].t[j];
+		vector<int> remap = FirstUseRemap(mapCorners.data(), mapCorners.size(), tNum);
+		vector<UVVert> mapVerts(mesh.tVerts, mesh.tVerts + tNum);
+		for (size_t i = 0; i < tNum; i++) mesh.tVerts[remap[i]] = mapVerts[i];
+		MULTI_THREAD_LOOP_BEGIN(fNum)
+		for (int j = 0; j < 3; j++) mesh.tvFace[i].t[j] = (DWORD)remap[mapCorners[i * 3 + j]];
+		MULTI_THREAD_LOOP_END
+	}
 
-		// Clear Up
-		if (cacheBufferingMode == DISK_CACHE_BUFFERING_MODE) {
-			filesystem::remove(tempAddr + "\\max-mesh.vtx");
-			filesystem::remove(tempAddr + "\\max-mesh.nrm");
-			filesystem::remove(tempAddr + "\\max-mesh.tex");
-			filesystem::remove(tempAddr + "\\max-mesh.idx");
-			filesystem::remove(tempAddr + "\\max-mesh.tdx");
-			filesystem::remove(tempAddr + "\\max-mesh.ndx");
-			filesystem::remove(tempAddr + "\\max-mesh.mta");
-		}
-		if (cacheBufferingMode == MEMORY_CACHE_BUFFERING_MODE) {
-			vtxBuffer.clear(); stringstream().swap(vtxBuffer);
-			nrmBuffer.clear(); stringstream().swap(nrmBuffer);
-			texBuffer.clear(); stringstream().swap(texBuffer);
-			idxBuffer.clear(); stringstream().swap(idxBuffer);
-			tdxBuffer.clear(); stringstream().swap(tdxBuffer);
-			ndxBuffer.clear(); stringstream().swap(ndxBuffer);
-			mtaBuffer.clear(); stringstream().swap(mtaBuffer);
+	// Normals In Order Of First Use, Unset Corners Stay Unset
+	if (nNum && mesh_ns)
+	{
+		MeshNormalFace* normalFaces = mesh_ns->GetFaceArray();
+		vector<MeshNormalFace> sourceFaces(normalFaces, normalFaces + fNum);
+		vector<int> normalCorners(fNum * 3);
+		for (size_t i = 0; i < fNum; i++)
+			for (int j = 0; j < 3; j++) normalCorners[i * 3 + j] = sourceFaces[faceOrder[i]].GetNormalID(j);
+		vector<int> remap = FirstUseRemap(normalCorners.data(), normalCorners.size(), nNum);
+		Point3* normals = mesh_ns->GetNormalArray();
+		vector<Point3> sourceNormals(normals, normals + nNum);
+		for (size_t i = 0; i < nNum; i++) normals[remap[i]] = sourceNormals[i];
+		MULTI_THREAD_LOOP_BEGIN(fNum)
+		normalFaces[i] = sourceFaces[faceOrder[i]];
+		for (int j = 0; j < 3; j++)
+		{
+			int id = normalCorners[i * 3 + j];
+			normalFaces[i].SetNormalID(j, id < 0 ? -1 : remap[id]);
 		}
-
-		DebugLog(L"Object [%s] successfully cached to %S in %f ms", node->GetName(), outputNameBuffer, profiler.ElapsedMilliseconds());
-		return true;
+		MULTI_THREAD_LOOP_END
 	}
 
-	DebugLog(L"Caching object [%s] failed.", node->GetName());
-	return false;
+	// Fingerprint Was Taken In The Source Order
+	meshMeta.topologyHash = 0;
 }
-bool GenerateNodeFromCache(const wchar_t* mxm_package)
+void ReorderPolyCapture(MeshCapture& capture, const UVVert* mapVerts)
 {
-	profiler.Reset(); profiler.Start();
-	DebugLog(L"Restoring object from cache file [%s]...", mxm_package);
-
-	if (restoreMode == RESTORE_CACHE_MODE_SINGLE_THREAD)
-		DebugLog(L"Config `Restore Mode` = RESTORE_CACHE_MODE_SINGLE_THREAD");
-	if (restoreMode == RESTORE_CACHE_MODE_MULTI_THREAD)
-		DebugLog(L"Config `Restore Mode` = RESTORE_CACHE_MODE_MULTI_THREAD");
-
-	// Convert Package Name
-	wstring mxm_package_ws(mxm_package);
-	string mxm_package_str(mxm_package_ws.begin(), mxm_package_ws.end());
-
-	// Create Object
-	TimeValue t = GetCOREInterface()->GetTime();
-	INode* newNode = CreateObjectInScene(GEOMOBJECT_CLASS_ID, EPOLYOBJ_CLASS_ID);
-	PolyObject* obj = (PolyObject*)newNode->GetObjectRef();
-	MNMesh& mesh = obj->GetMesh();
-
-	// Import Mesh
-	Unzipper unzipper(mxm_package_str.c_str());
-	BUFFER mta_buffer, vtx_buffer, nrm_buffer, tex_buffer, idx_buffer, tdx_buffer, ndx_buffer;
-
-	// Extracting
-	unzipper.extractEntryToMemory("max-mesh.mta", mta_buffer);
-	unzipper.extractEntryToMemory("max-mesh.vtx", vtx_buffer);
-	unzipper.extractEntryToMemory("max-mesh.nrm", nrm_buffer);
-	unzipper.extractEntryToMemory("max-mesh.tex", tex_buffer);
-	unzipper.extractEntryToMemory("max-mesh.idx", idx_buffer);
-	unzipper.extractEntryToMemory("max-mesh.tdx", tdx_buffer);
-	unzipper.extractEntryToMemory("max-mesh.ndx", ndx_buffer);
-	unzipper.close();
+	ScopedStage stage(opStats, "reorder");
+	MaxMeshMetaData& meshMeta = capture.meta;
+	size_t vNum = meshMeta.vNum, fNum = meshMeta.fNum, cNum = meshMeta.cNum, tNum = meshMeta.tNum, nNum = meshMeta.nNum;
 
-	// Creating Mesh
-	Mesh* newMesh = new Mesh();
-	newMesh->SpecifyNormals(); // Needed?
-	MeshNormalSpec* mesh_ns = newMesh->GetSpecifiedNormals();
-	MaxMeshMetaData* meshMeta = (MaxMeshMetaData*)mta_buffer.data();
+	// Working Copies Of The Largest Channels
+	ScopedCharge reorderCharge(memoryLedger, LedgerStaging, vNum * (sizeof(Point3) + 2 * sizeof(int)) +
+		fNum * (sizeof(MaxMeshPolyFace) + 4 * sizeof(size_t)) + cNum * 2 * sizeof(int) + tNum * (sizeof(UVVert) + sizeof(int)) + nNum * (sizeof(Point3) + sizeof(int) + 1));
+	if (!IsMemoryGranted(reorderCharge, L"locality reorder")) return;
 
-	// Set Configs
-	newNode->SetName(StringGetWideChar(meshMeta->name));
-	newNode->SetNodeTM(t, meshMeta->tm);
-	newNode->SetWireColor(meshMeta->col);
+	// Vertices Along a Space Filling Curve
+	vector<int> vertexOrder = SpatialOrder((const Position*)capture.points.data(), vNum);
+	vector<int> vertexRemap = InvertOrder(vertexOrder);
+	vector<Point3> points(vNum);
+	MULTI_THREAD_LOOP_BEGIN(vNum)
+	points[i] = capture.points[vertexOrder[i]];
+	MULTI_THREAD_LOOP_END
+	capture.points.swap(points);
+	MULTI_THREAD_LOOP_BEGIN(cNum)
+	capture.corners[i] = vertexRemap[capture.corners[i]];
+	MULTI_THREAD_LOOP_END
 
-	// Allocate Sizes
-	newMesh->setNumVerts(meshMeta->vNum);
-	mesh_ns->SetNumNormals(meshMeta->nNum);
-	newMesh->setNumTVerts(meshMeta->tNum);
-	newMesh->setNumFaces(meshMeta->fNum);
-	newMesh->setNumTVFaces(meshMeta->fNum);
-	mesh_ns->SetNumFaces(meshMeta->fNum);
-
-	// Copy Buffers
-	if (restoreMode == RESTORE_CACHE_MODE_SINGLE_THREAD)
+	// Faces In Vertex Cache Order, Every Corner Channel Follows Its Face
+	vector<int> faceOrder = CacheOrder(capture.degrees.data(), capture.corners.data(), fNum, vNum);
+	vector<size_t> offsets(fNum + 1, 0), reordered(fNum + 1, 0);
+	for (size_t i = 0; i < fNum; i++)
 	{
-		memcpy(newMesh->verts, vtx_buffer.data(), vtx_buffer.size());
-		memcpy(mesh_ns->GetNormalArray(), nrm_buffer.data(), nrm_buffer.size());
-		memcpy(newMesh->tVerts, tex_buffer.data(), tex_buffer.size());
-		memcpy(newMesh->faces, idx_buffer.data(), idx_buffer.size());
-		memcpy(newMesh->tvFace, tdx_buffer.data(), tdx_buffer.size());
-		memcpy(mesh_ns->GetFaceArray(), ndx_buffer.data(), ndx_buffer.size());
+		offsets[i + 1] = offsets[i] + capture.degrees[i];
+		reordered[i + 1] = reordered[i] + capture.degrees[faceOrder[i]];
 	}
-	if (restoreMode == RESTORE_CACHE_MODE_MULTI_THREAD)
+	auto permuteCorners = [&](auto& channel)
 	{
-		Point3* vertBuffer						= (Point3*)vtx_buffer.data();
-		Point3* normalBuffer					= (Point3*)nrm_buffer.data();
-		UVVert* textureBuffer					= (UVVert*)tex_buffer.data();
-		Face* faceBuffer						= (Face*)idx_buffer.data();
-		TVFace* textureFaceBuffer				= (TVFace*)tdx_buffer.data();
-		MeshNormalFace* normalFaceBuffer		= (MeshNormalFace*)ndx_buffer.data();
-
-		MULTI_THREAD_LOOP_BEGIN(meshMeta->vNum)
-		newMesh->verts[i] = vertBuffer[i];
+		if (channel.empty()) return;
+		auto permuted = channel;
+		MULTI_THREAD_LOOP_BEGIN(fNum)
+		size_t source = offsets[faceOrder[i]];
+		memcpy(&permuted[reordered[i]], &channel[source], (offsets[faceOrder[i] + 1] - source) * sizeof(channel[0]));
 		MULTI_THREAD_LOOP_END
+		channel.swap(permuted);
+	};
+	permuteCorners(capture.corners);
+	permuteCorners(capture.mapCorners);
+	permuteCorners(capture.normalCorners);
+	permuteCorners(capture.cornerFlags);
+	vector<int> degrees(fNum);
+	vector<MaxMeshPolyFace> faces(fNum);
+	MULTI_THREAD_LOOP_BEGIN(fNum)
+	degrees[i] = capture.degrees[faceOrder[i]];
+	faces[i] = capture.faces[faceOrder[i]];
+	MULTI_THREAD_LOOP_END
+	capture.degrees.swap(degrees);
+	capture.faces.swap(faces);
 
-		MULTI_THREAD_LOOP_BEGIN(meshMeta->nNum)
-		mesh_ns->GetNormalArray()[i] = normalBuffer[i];
+	// Texture Vertices In Order Of First Use, Owned From Here On
+	if (tNum && mapVerts)
+	{
+		vector<int> remap = FirstUseRemap(capture.mapCorners.data(), cNum, tNum);
+		capture.mapVerts.resize(tNum);
+		for (size_t i = 0; i < tNum; i++) capture.mapVerts[remap[i]] = mapVerts[i];
+		MULTI_THREAD_LOOP_BEGIN(cNum)
+		int& id = capture.mapCorners[i];
+		if (id >= 0) id = remap[id];
 		MULTI_THREAD_LOOP_END
+	}
 
-		MULTI_THREAD_LOOP_BEGIN(meshMeta->tNum)
-		newMesh->tVerts[i] = textureBuffer[i];
+	// Normals In Order Of First Use, Unset Corners Stay Unset
+	if (nNum)
+	{
+		vector<int> remap = FirstUseRemap(capture.normalCorners.data(), cNum, nNum);
+		vector<Point3> normals(nNum);
+		vector<BYTE> normalFlags(nNum);
+		for (size_t i = 0; i < nNum; i++)
+		{
+			normals[remap[i]] = capture.normals[i];
+			normalFlags[remap[i]] = capture.normalFlags[i];
+		}
+		capture.normals.swap(normals);
+		capture.normalFlags.swap(normalFlags);
+		MULTI_THREAD_LOOP_BEGIN(cNum)
+		int& id = capture.normalCorners[i];
+		if (id >= 0) id = remap[id];
 		MULTI_THREAD_LOOP_END
+	}
 
-		MULTI_THREAD_LOOP_BEGIN(meshMeta->fNum)
-		newMesh->faces[i] = faceBuffer[i];
-		newMesh->tvFace[i] = textureFaceBuffer[i];
-		mesh_ns->GetFaceArray()[i] = normalFaceBuffer[i];
-		MULTI_THREAD_LOOP_END
+	// Fingerprint Of The Stored Order, Restores Onto The Source Mesh Rebuild It
+	meshMeta.topologyHash = HashTopology(meshMeta.vNum, meshMeta.fNum, [&](size_t i, int& deg, const int*& vtx) {
+		deg = capture.degrees[i];
+		vtx = &capture.corners[reordered[i]];
+	});
+}
+bool CaptureTriMesh(Object* obj, TimeValue t, MeshCapture& capture)
+{
+	// Get Tri Object
+	TriObject* tobj = nullptr;
+	{
+		ScopedStage stage(opStats, "convert");
+		tobj = (TriObject*)obj->ConvertToType(t, triobjectCID); if (!tobj) { return false; }
 	}
-	
-	// Finalaizing
-	mesh.SetFromTri(*newMesh);
-	mesh.InvalidateGeomCache();
-	mesh.InvalidateTopoCache();
+	if (tobj != obj) capture.converted = tobj;
 
-	// Merge Tris
-	mesh.MakePolyMesh();
-	
-	// Releasing
-	newMesh->FreeAll();
-	delete newMesh; BUFFER_FREE(mta_buffer);
-	BUFFER_FREE(vtx_buffer); BUFFER_FREE(nrm_buffer);
-	BUFFER_FREE(tex_buffer); BUFFER_FREE(idx_buffer);
-	BUFFER_FREE(tdx_buffer); BUFFER_FREE(ndx_buffer);
+	// Get Mesh
+	Mesh& mesh = capture.triMesh;
+	mesh = tobj->GetMesh();
 
-	// Update 
-	GetCOREInterface()->RedrawViews(t);
-	obj->NotifyDependents(FOREVER, ALL_CHANNELS, REFMSG_CHANGE);
+	// Compute Normals
+	MeshNormalSpec* mesh_ns = nullptr;
+	{
+		ScopedStage stage(opStats, "normals");
+		mesh.SpecifyNormals();
+		mesh_ns = mesh.GetSpecifiedNormals();
+		mesh_ns->CheckNormals();
+	}
 
-	DebugLog(L"Cache [%s] successfully restored to %s in %f ms",
-		mxm_package,
-		newNode->GetName(),
-		profiler.ElapsedMilliseconds());
+	// Get Mesh Data Sizes
+	MaxMeshMetaData& meshMeta = capture.meta;
+	meshMeta.topology = CACHE_TOPOLOGY_MODE_TRI;
+	meshMeta.vNum = mesh.numVerts;
+	meshMeta.nNum = mesh_ns->GetNumNormals();
+	meshMeta.fNum = mesh.numFaces;
+	meshMeta.tNum = mesh.numTVerts;
+
+	// Topology Fingerprint, Triangulating a Poly Object Keeps Its Vertex Order
+	if (obj->IsSubClassOf(polyObjectClassID) && ((PolyObject*)obj)->GetMesh().numv == meshMeta.vNum)
+		meshMeta.topologyHash = HashTopology(((PolyObject*)obj)->GetMesh());
+	if (capture.reorder) ReorderTriCapture(capture);
 
+	// Channel Views
+	capture.AddChannel("max-mesh.vtx", mesh.verts, meshMeta.vNum);
+	capture.AddChannel("max-mesh.nrm", mesh_ns->GetNormalArray(), meshMeta.nNum);
+	capture.AddChannel("max-mesh.tex", mesh.tVerts, meshMeta.tNum);
+	capture.AddChannel("max-mesh.idx", mesh.faces, meshMeta.fNum);
+	capture.AddChannel("max-mesh.tdx", mesh.tvFace, meshMeta.fNum);
+	capture.AddChannel("max-mesh.ndx", mesh_ns->GetFaceArray(), meshMeta.fNum);
 	return true;
 }
-bool GenerateNewPolyFromCache(const wchar_t* mxm_package, INode* node)
+bool CapturePolyMesh(Object* obj, TimeValue t, MeshCapture& capture)
 {
-	theHold.Begin();
-	profiler.Reset(); profiler.Start();
-	DebugLog(L"Restoring mesh from cache file [%s]...", mxm_package);
-
-	if (restoreMode == RESTORE_CACHE_MODE_SINGLE_THREAD)
-		DebugLog(L"Config `Restore Mode` = RESTORE_CACHE_MODE_SINGLE_THREAD");
-	if (restoreMode == RESTORE_CACHE_MODE_MULTI_THREAD)
-		DebugLog(L"Config `Restore Mode` = RESTORE_CACHE_MODE_MULTI_THREAD");
-
-	// Convert Package Name
-	wstring mxm_package_ws(mxm_package);
-	string mxm_package_str(mxm_package_ws.begin(), mxm_package_ws.end());
-
 	// Get Poly Object
-	PolyObject* obj = (PolyObject*)node->GetObjectRef();
-
-	// Geometry Validation
-	if (obj->FindBaseObject()->SuperClassID() != GEOMOBJECT_CLASS_ID) return false;
-
-	// Editable Poly Validation 
-	if (obj->FindBaseObject()->ClassID() != EPOLYOBJ_CLASS_ID) return false;
+	PolyObject* pobj = nullptr;
+	{
+		ScopedStage stage(opStats, "convert");
+		pobj = (PolyObject*)obj->ConvertToType(t, polyObjectClassID); if (!pobj) { return false; }
+	}
+	if (pobj != obj) capture.converted = pobj;
 
-	// Create Undo/Redo Backup
-	theHold.Put(new RestoreMeshOp(obj, mxm_package, node));
+	// Get Mesh, Compacted Only When It Carries Dead Elements
+	MNMesh* source = &pobj->GetMesh();
+	bool hasDeadElements = false;
+	for (int i = 0; i < source->numv && !hasDeadElements; i++) hasDeadElements = source->v[i].GetFlag(MN_DEAD);
+	for (int i = 0; i < source->numf && !hasDeadElements; i++) hasDeadElements = source->f[i].GetFlag(MN_DEAD);
+	if (hasDeadElements)
+	{
+		capture.polyMesh = *source;
+		capture.polyMesh.CollapseDeadStructs();
+		source = &capture.polyMesh;
+	}
+	MNMesh& mesh = *source;
 
-	// Get Mesh
-	MNMesh& mesh = obj->GetMesh();
+	MaxMeshMetaData& meshMeta = capture.meta;
+	meshMeta.topology = CACHE_TOPOLOGY_MODE_POLY;
+	meshMeta.vNum = mesh.numv;
+	meshMeta.fNum = mesh.numf;
 
-	// Import Mesh
-	Unzipper unzipper(mxm_package_str.c_str());
-	BUFFER mta_buffer, vtx_buffer, nrm_buffer, tex_buffer, idx_buffer, tdx_buffer, ndx_buffer;
+	// Polygon Degrees
+	vector<size_t> offsets(meshMeta.fNum + 1, 0);
+	capture.degrees.resize(meshMeta.fNum);
+	for (int i = 0; i < meshMeta.fNum; i++)
+	{
+		capture.degrees[i] = mesh.f[i].deg;
+		offsets[i + 1] = offsets[i] + mesh.f[i].deg;
+	}
+	meshMeta.cNum = (int)offsets[meshMeta.fNum];
 
-	// Extracting
-	unzipper.extractEntryToMemory("max-mesh.mta", mta_buffer);
-	unzipper.extractEntryToMemory("max-mesh.vtx", vtx_buffer);
-	unzipper.extractEntryToMemory("max-mesh.nrm", nrm_buffer);
-	unzipper.extractEntryToMemory("max-mesh.tex", tex_buffer);
-	unzipper.extractEntryToMemory("max-mesh.idx", idx_buffer);
-	unzipper.extractEntryToMemory("max-mesh.tdx", tdx_buffer);
-	unzipper.extractEntryToMemory("max-mesh.ndx", ndx_buffer);
-	unzipper.close();
+	// Vertices, Corners, Face Data
+	capture.points.resize(meshMeta.vNum);
+	capture.corners.resize(meshMeta.cNum);
+	capture.faces.resize(meshMeta.fNum);
+	MULTI_THREAD_LOOP_BEGIN(meshMeta.vNum)
+	capture.points[i] = mesh.v[i].p;
+	MULTI_THREAD_LOOP_END
+	MULTI_THREAD_LOOP_BEGIN(meshMeta.fNum)
+	const MNFace& face = mesh.f[i];
+	memcpy(&capture.corners[offsets[i]], face.vtx, face.deg * sizeof(int));
+	capture.faces[i].smGroup = face.smGroup;
+	capture.faces[i].material = face.material;
+	capture.faces[i].flags = 0;
+	MULTI_THREAD_LOOP_END
 
-	// Creating Mesh
-	Mesh* newMesh = new Mesh();
-	newMesh->SpecifyNormals();
-	MeshNormalSpec* mesh_ns = newMesh->GetSpecifiedNormals();
-	MaxMeshMetaData* meshMeta = (MaxMeshMetaData*)mta_buffer.data();
+	// Topology Fingerprint
+	meshMeta.topologyHash = HashTopology(meshMeta.vNum, meshMeta.fNum, [&](size_t i, int& deg, const int*& vtx) {
+		deg = capture.degrees[i];
+		vtx = &capture.corners[offsets[i]];
+	});
 
-	// Allocate Sizes
-	newMesh->setNumVerts(meshMeta->vNum);
-	mesh_ns->SetNumNormals(meshMeta->nNum);
-	newMesh->setNumTVerts(meshMeta->tNum);
-	newMesh->setNumFaces(meshMeta->fNum);
-	newMesh->setNumTVFaces(meshMeta->fNum);
-	mesh_ns->SetNumFaces(meshMeta->fNum);
-
-	// Copy Buffers
-	if (restoreMode == RESTORE_CACHE_MODE_SINGLE_THREAD)
+	// Texture Map Channel
+	MNMap* map = mesh.MNum() > 1 ? mesh.M(1) : nullptr;
+	if (map && !map->GetFlag(MN_DEAD) && map->numf == meshMeta.fNum)
 	{
-		memcpy(newMesh->verts, vtx_buffer.data(), vtx_buffer.size());
-		memcpy(mesh_ns->GetNormalArray(), nrm_buffer.data(), nrm_buffer.size());
-		memcpy(newMesh->tVerts, tex_buffer.data(), tex_buffer.size());
-		memcpy(newMesh->faces, idx_buffer.data(), idx_buffer.size());
-		memcpy(newMesh->tvFace, tdx_buffer.data(), tdx_buffer.size());
-		memcpy(mesh_ns->GetFaceArray(), ndx_buffer.data(), ndx_buffer.size());
+		meshMeta.tNum = map->numv;
+		capture.mapCorners.resize(meshMeta.cNum);
+		MULTI_THREAD_LOOP_BEGIN(meshMeta.fNum)
+		memcpy(&capture.mapCorners[offsets[i]], map->f[i].tv, map->f[i].deg * sizeof(int));
+		MULTI_THREAD_LOOP_END
 	}
-	if (restoreMode == RESTORE_CACHE_MODE_MULTI_THREAD)
-	{
-		Point3* vertBuffer = (Point3*)vtx_buffer.data();
-		Point3* normalBuffer = (Point3*)nrm_buffer.data();
-		UVVert* textureBuffer = (UVVert*)tex_buffer.data();
-		Face* faceBuffer = (Face*)idx_buffer.data();
-		TVFace* textureFaceBuffer = (TVFace*)tdx_buffer.data();
-		MeshNormalFace* normalFaceBuffer = (MeshNormalFace*)ndx_buffer.data();
 
-		MULTI_THREAD_LOOP_BEGIN(meshMeta->vNum)
-		newMesh->verts[i] = vertBuffer[i];
-		MULTI_THREAD_LOOP_END
-		MULTI_THREAD_LOOP_BEGIN(meshMeta->nNum)
-		mesh_ns->GetNormalArray()[i] = normalBuffer[i];
-		MULTI_THREAD_LOOP_END
-		MULTI_THREAD_LOOP_BEGIN(meshMeta->tNum)
-		newMesh->tVerts[i] = textureBuffer[i];
-		MULTI_THREAD_LOOP_END
-		MULTI_THREAD_LOOP_BEGIN(meshMeta->fNum)
-		newMesh->faces[i] = faceBuffer[i];
-		newMesh->tvFace[i] = textureFaceBuffer[i];
-		mesh_ns->GetFaceArray()[i] = normalFaceBuffer[i];
+	// Specified Normals
+	MNNormalSpec* mesh_ns = mesh.GetSpecifiedNormals();
+	if (mesh_ns && mesh_ns->GetNumFaces() == meshMeta.fNum)
+	{
+		ScopedStage stage(opStats, "normals");
+		mesh_ns->CheckNormals();
+		meshMeta.nNum = mesh_ns->GetNumNormals();
+		capture.normals.resize(meshMeta.nNum);
+		capture.normalFlags.resize(meshMeta.nNum);
+		capture.normalCorners.resize(meshMeta.cNum);
+		capture.cornerFlags.resize(meshMeta.cNum);
+		for (int i = 0; i < meshMeta.nNum; i++)
+		{
+			capture.normals[i] = mesh_ns->Normal(i);
+			capture.normalFlags[i] = mesh_ns->GetNormalExplicit(i) ? 1 : 0;
+		}
+		MULTI_THREAD_LOOP_BEGIN(meshMeta.fNum)
+		MNNormalFace& normalFace = mesh_ns->Face(i);
+		for (int j = 0; j < capture.degrees[i]; j++)
+		{
+			capture.normalCorners[offsets[i] + j] = normalFace.GetNormalID(j);
+			capture.cornerFlags[offsets[i] + j] = normalFace.GetSpecified(j) ? 1 : 0;
+		}
 		MULTI_THREAD_LOOP_END
 	}
+	if (capture.reorder) ReorderPolyCapture(capture, meshMeta.tNum ? map->v : nullptr);
 
-	// Finalaizing
-	mesh.SetFromTri(*newMesh);
-	mesh.InvalidateGeomCache();
-	mesh.InvalidateTopoCache();
+	// Layout Fingerprint Of The Stored Order, Offsets Follow The Reordered Faces
+	for (int i = 0; i < meshMeta.fNum; i++) offsets[i + 1] = offsets[i] + capture.degrees[i];
+	meshMeta.layoutHash = HashLayout(meshMeta.tNum, meshMeta.nNum, meshMeta.fNum, [&](UINT64 hash, size_t i)
+	{
+		hash = HashValue(HashValue(hash, (UINT64)capture.faces[i].smGroup), (UINT64)capture.faces[i].material);
+		if (meshMeta.tNum) for (size_t j = offsets[i]; j < offsets[i + 1]; j++) hash = HashValue(hash, (UINT64)(UINT32)capture.mapCorners[j]);
+		if (meshMeta.nNum) for (size_t j = offsets[i]; j < offsets[i + 1]; j++) hash = HashValue(HashValue(hash, (UINT64)(UINT32)capture.normalCorners[j]), capture.cornerFlags[j] ? 1 : 0);
+		return hash;
+	});
 
-	// Merge Tris
-	mesh.MakePolyMesh();
+	// Channel Views
+	capture.AddChannel("max-mesh.vtx", capture.points.data(), meshMeta.vNum);
+	capture.AddChannel("max-mesh.pdg", capture.degrees.data(), meshMeta.fNum);
+	capture.AddChannel("max-mesh.pvx", capture.corners.data(), meshMeta.cNum);
+	capture.AddChannel("max-mesh.pfd", capture.faces.data(), meshMeta.fNum);
+	if (meshMeta.tNum)
+	{
+		capture.AddChannel("max-mesh.tex", capture.mapVerts.empty() ? map->v : capture.mapVerts.data(), meshMeta.tNum);
+		capture.AddChannel("max-mesh.ptx", capture.mapCorners.data(), meshMeta.cNum);
+	}
+	if (meshMeta.nNum)
+	{
+		capture.AddChannel("max-mesh.nrm", capture.normals.data(), meshMeta.nNum);
+		capture.AddChannel("max-mesh.pne", capture.normalFlags.data(), meshMeta.nNum);
+		capture.AddChannel("max-mesh.pnx", capture.normalCorners.data(), meshMeta.cNum);
+		capture.AddChannel("max-mesh.pns", capture.cornerFlags.data(), meshMeta.cNum);
+	}
+	return true;
+}
+void CaptureBounds(MeshCapture& capture)
+{
+	// Stored In The Header, Proxies Are Built Without Touching The Vertices
+	capture.meta.bounds.Init();
+	for (auto& channel : capture.channels)
+	{
+		if (strcmp(channel.entry, "max-mesh.vtx") != 0) continue;
+		const Point3* points = (const Point3*)channel.data;
+		for (size_t i = 0; i < channel.size / sizeof(Point3); i++) capture.meta.bounds += points[i];
+	}
+}
+bool CaptureMesh(INode* node, TimeValue t, MeshCapture& capture)
+{
+	ScopedStage stage(opStats, "capture");
+	Object* obj = nullptr;
+	{
+		ScopedStage evaluate(opStats, "evaluate");
+		obj = node->EvalWorldState(t).obj;
+	}
+	if (!obj) { return false; }
 
-	// Releasing
-	newMesh->FreeAll();
-	delete newMesh; BUFFER_FREE(mta_buffer);
-	BUFFER_FREE(vtx_buffer); BUFFER_FREE(nrm_buffer);
-	BUFFER_FREE(tex_buffer); BUFFER_FREE(idx_buffer);
-	BUFFER_FREE(tdx_buffer); BUFFER_FREE(ndx_buffer);
+	CaptureMeta(node, t, capture.meta);
 
-	// Update 
-	GetCOREInterface()->RedrawViews(GetCOREInterface()->GetTime());
-	obj->NotifyDependents(FOREVER, ALL_CHANNELS, REFMSG_CHANGE);
+	bool captured = false;
+	if (cacheTopologyMode == CACHE_TOPOLOGY_MODE_POLY && obj->CanConvertToType(polyObjectClassID))
+		captured = CapturePolyMesh(obj, t, capture);
+	else if (obj->CanConvertToType(triobjectCID))
+		captured = CaptureTriMesh(obj, t, capture);
 
-	DebugLog(L"Cache [%s] successfully restored to %s in %f ms", mxm_package, node->GetName(), profiler.ElapsedMilliseconds());
+	if (captured) CaptureBounds(capture);
+	if (captured) capture.AddChannel("max-mesh.mta", &capture.meta, 1);
+	return captured;
+}
+bool IsChunkEntry(const string& entry)
+{
+	return entry.compare(0, strlen(CHUNK_ENTRY_PREFIX), CHUNK_ENTRY_PREFIX) == 0;
+}
+void WriteMeshChannels(const MeshCapture& capture, Zipper& zipper, Zipper::zipFlags flags, BYTE bufferingMode)
+{
+	// Get Temp Path
+	string tempAddr = filesystem::temp_directory_path().string();
 
-	theHold.Accept(L"MXMesh :: RestoreMesh");
+	// Compressing, One Channel Buffered At a Time
+	ScopedStage stage(opStats, "compress");
+	for (auto& channel : capture.channels)
+	{
+		TraceScope trace("deflate", "channel", channel.entry);
+		auto start = chrono::steady_clock::now();
+
+		// Spatial Chunks Arrive Deflated, Stored As They Are
+		Zipper::zipFlags channelFlags = IsChunkEntry(channel.entry) ? Zipper::Store : flags;
+		if (bufferingMode == DISK_CACHE_BUFFERING_MODE)
+		{
+			string channelPath = tempAddr + "\\" + channel.entry;
+			fileWritter.open(channelPath, ios::binary | ios::out);
+			fileWritter.write((const char*)channel.data, channel.size);
+			fileWritter.close();
+			zipper.add(channelPath, channelFlags);
+			filesystem::remove(channelPath);
+		}
+		if (bufferingMode == MEMORY_CACHE_BUFFERING_MODE)
+		{
+			RegionInStream channelBuffer(channel.data, channel.size);
+			zipper.add(channelBuffer, channel.entry, channelFlags);
+		}
+		opStats.AddChannel(channel.entry, channel.size, 0, ElapsedMilliseconds(start));
+		stage.AddBytes(channel.size);
+	}
+	zipper.close();
+}
+void WriteMeshPackage(const MeshCapture& capture, const char* outputPath)
+{
+	// Remove Package If Exists
+	std::remove(outputPath);
+
+	Zipper zipper(outputPath);
+	WriteMeshChannels(capture, zipper, compressionMode, cacheBufferingMode);
+}
+void WriteMeshPackage(const MeshCapture& capture, Package& package, Zipper::zipFlags flags = compressionMode)
+{
+	// Already In Memory, Channels Are Never Staged On Disk
+	Zipper zipper(package);
+	WriteMeshChannels(capture, zipper, flags, MEMORY_CACHE_BUFFERING_MODE);
+}
+const char* LodEntry(int level)
+{
+	static const char* entries[MAX_LOD_LEVELS] = { LOD_ENTRY_PREFIX "1", LOD_ENTRY_PREFIX "2", LOD_ENTRY_PREFIX "3", LOD_ENTRY_PREFIX "4" };
+	return entries[level - 1];
+}
+bool IsLodEntry(const string& entry)
+{
+	return entry.compare(0, strlen(LOD_ENTRY_PREFIX), LOD_ENTRY_PREFIX) == 0;
+}
+void GatherTriangles(const MeshCapture& capture, vector<LodVertex>& vertices, vector<LodTriangle>& triangles, vector<MaxMeshPolyFace>& attributes)
+{
+	const MaxMeshMetaData& meshMeta = capture.meta;
+	if (meshMeta.topology == CACHE_TOPOLOGY_MODE_POLY)
+	{
+		// Polygons Fanned From Their First Corner
+		const LodVertex* points = (const LodVertex*)capture.points.data();
+		vertices.assign(points, points + meshMeta.vNum);
+		attributes = capture.faces;
+		size_t offset = 0;
+		for (int i = 0; i < meshMeta.fNum; i++)
+		{
+			const int* corners = &capture.corners[offset];
+			for (int j = 2; j < capture.degrees[i]; j++) triangles.push_back(LodTriangle{ { corners[0], corners[j - 1], corners[j] }, i });
+			offset += capture.degrees[i];
+		}
+		return;
+	}
+
+	const Mesh& mesh = capture.triMesh;
+	const LodVertex* points = (const LodVertex*)mesh.verts;
+	vertices.assign(points, points + meshMeta.vNum);
+	triangles.resize(meshMeta.fNum);
+	attributes.resize(meshMeta.fNum);
+	for (int i = 0; i < meshMeta.fNum; i++)
+	{
+		Face& face = mesh.faces[i];
+		triangles[i] = LodTriangle{ { (int)face.v[0], (int)face.v[1], (int)face.v[2] }, i };
+		attributes[i] = MaxMeshPolyFace{ face.smGroup, face.getMatID(), 0 };
+	}
+}
+void BuildLodPackages(MeshCapture& capture)
+{
+	if (cacheLodLevels <= 0 || capture.meta.fNum == 0) return;
+	ScopedStage stage(opStats, "lods");
+	auto start = chrono::steady_clock::now();
+
+	// Source Triangles, Charged While The Levels Are Built
+	vector<LodVertex> vertices;
+	vector<LodTriangle> triangles;
+	vector<MaxMeshPolyFace> attributes;
+	ScopedCharge sourceCharge(memoryLedger, LedgerStaging, (uint64_t)capture.meta.vNum * sizeof(LodVertex) +
+		(uint64_t)max(capture.meta.cNum, capture.meta.fNum * 3) * sizeof(LodTriangle) + (uint64_t)capture.meta.fNum * sizeof(MaxMeshPolyFace));
+	if (!IsMemoryGranted(sourceCharge, L"LOD source")) return;
+	GatherTriangles(capture, vertices, triangles, attributes);
+
+	// Levels Built Concurrently, Every Level Reduced By The Ratio Again
+	capture.lodPackages.resize(cacheLodLevels);
+	vector<size_t> faceCounts(cacheLodLevels, 0);
+	parallel_for(0, cacheLodLevels, [&](int level)
+	{
+		TraceScope trace("simplify", "lod");
+		size_t target = (size_t)(triangles.size() * pow((double)cacheLodRatio, level + 1));
+		LodMesh lod = Simplify(vertices.data(), vertices.size(), triangles.data(), triangles.size(), target);
+		if (lod.triangles.empty()) return;
+
+		// Plain Triangles, UVs & Normals Are Left To The Full Mesh
+		MeshCapture lodCapture;
+		MaxMeshMetaData& lodMeta = lodCapture.meta;
+		lodMeta = capture.meta;
+		lodMeta.topology = CACHE_TOPOLOGY_MODE_POLY;
+		lodMeta.vNum = (int)lod.vertices.size();
+		lodMeta.fNum = (int)lod.triangles.size();
+		lodMeta.cNum = lodMeta.fNum * 3;
+		lodMeta.tNum = lodMeta.nNum = 0;
+		lodMeta.topologyHash = lodMeta.layoutHash = 0;
+		lodCapture.degrees.assign(lodMeta.fNum, 3);
+		lodCapture.corners.resize(lodMeta.cNum);
+		lodCapture.faces.resize(lodMeta.fNum);
+		for (int i = 0; i < lodMeta.fNum; i++)
+		{
+			memcpy(&lodCapture.corners[i * 3], lod.triangles[i].v, 3 * sizeof(int));
+			lodCapture.faces[i] = attributes[lod.triangles[i].source];
+		}
+		lodCapture.AddChannel("max-mesh.vtx", (const Point3*)lod.vertices.data(), lodMeta.vNum);
+		lodCapture.AddChannel("max-mesh.pdg", lodCapture.degrees.data(), lodMeta.fNum);
+		lodCapture.AddChannel("max-mesh.pvx", lodCapture.corners.data(), lodMeta.cNum);
+		lodCapture.AddChannel("max-mesh.pfd", lodCapture.faces.data(), lodMeta.fNum);
+		lodCapture.AddChannel("max-mesh.mta", &lodMeta, 1);
+
+		// Stored, The Outer Package Deflates It Once
+		WriteMeshPackage(lodCapture, capture.lodPackages[level], Zipper::Store);
+		faceCounts[level] = lod.triangles.size();
+	});
+
+	// Coarser Levels Only Exist Below Every Finer One
+	for (int level = 1; level <= cacheLodLevels && faceCounts[level - 1]; level++)
+	{
+		Package& package = capture.lodPackages[level - 1];
+		capture.AddChannel(LodEntry(level), package.data(), package.size());
+		DebugLog(L"LOD %d : %llu triangles.", level, (unsigned long long)faceCounts[level - 1]);
+	}
+	DebugLog(L"%d LOD levels of %llu triangles built in %f ms.", cacheLodLevels, (unsigned long long)triangles.size(), ElapsedMilliseconds(start));
+}
+void BuildChunkPackages(MeshCapture& capture)
+{
+	MaxMeshMetaData& meshMeta = capture.meta;
+	if (cacheChunkCells <= 0 || meshMeta.fNum == 0) return;
+	if (meshMeta.topology != CACHE_TOPOLOGY_MODE_POLY)
+	{
+		DebugLog(L"Spatial chunks need polygon topology, package written whole.");
+		return;
+	}
+	ScopedStage stage(opStats, "chunks");
+	auto start = chrono::steady_clock::now();
+
+	// Every Channel Is Held Once More Until The Blocks Are Deflated
+	uint64_t rawBytes = 0;
+	for (auto& channel : capture.channels) rawBytes += channel.size;
+	ScopedCharge chunkCharge(memoryLedger, LedgerStaging, rawBytes + (uint64_t)meshMeta.fNum * sizeof(pair<UINT64, int>));
+	if (!IsMemoryGranted(chunkCharge, L"spatial chunks")) return;
+
+	// Corner Offsets & Texture Vertices
+	size_t fNum = meshMeta.fNum;
+	vector<size_t> offsets(fNum + 1, 0);
+	for (size_t i = 0; i < fNum; i++) offsets[i + 1] = offsets[i] + capture.degrees[i];
+	const UVVert* mapVerts = nullptr;
+	for (auto& channel : capture.channels) if (strcmp(channel.entry, "max-mesh.tex") == 0) mapVerts = (const UVVert*)channel.data;
+
+	// Faces Bucketed By The Cell Of Their Centroid, Cells In Morton Order
+	const Box3& bounds = meshMeta.bounds;
+	int cells = min(cacheChunkCells, MAX_CHUNK_CELLS);
+	vector<pair<UINT64, int>> keys(fNum);
+	MULTI_THREAD_LOOP_BEGIN(fNum)
+	Point3 centroid(0.0f, 0.0f, 0.0f);
+	for (size_t j = offsets[i]; j < offsets[i + 1]; j++) centroid = centroid + capture.points[capture.corners[j]];
+	centroid = centroid / (float)max(capture.degrees[i], 1);
+	UINT32 cell[3];
+	for (int a = 0; a < 3; a++)
+	{
+		float extent = bounds.pmax[a] - bounds.pmin[a];
+		float span = extent > 0 ? (centroid[a] - bounds.pmin[a]) / extent : 0.0f;
+		cell[a] = (UINT32)min(max((int)(span * cells), 0), cells - 1);
+	}
+	keys[i] = make_pair(MortonCode(cell[0], cell[1], cell[2]), (int)i);
+	MULTI_THREAD_LOOP_END
+	parallel_sort(keys.begin(), keys.end());
+	vector<size_t> runs{ 0 };
+	for (size_t i = 1; i < fNum; i++) if (keys[i].first != keys[i - 1].first) runs.push_back(i);
+	runs.push_back(fNum);
+	size_t chunkCount = runs.size() - 1;
+
+	// Loose Vertices, Texture Vertices & Normals Ride Along With The Last Cell
+	bool withMaps = meshMeta.tNum && mapVerts, withNormals = meshMeta.nNum != 0;
+	vector<bool> referenced(meshMeta.vNum, false), mapReferenced(withMaps ? meshMeta.tNum : 0, false), normalReferenced(withNormals ? meshMeta.nNum : 0, false);
+	for (int corner : capture.corners) referenced[corner] = true;
+	if (withMaps) for (int corner : capture.mapCorners) if (corner >= 0 && corner < meshMeta.tNum) mapReferenced[corner] = true;
+	if (withNormals) for (int corner : capture.normalCorners) if (corner >= 0 && corner < meshMeta.nNum) normalReferenced[corner] = true;
+	auto loose = [](const vector<bool>& used, vector<int>& ids) { for (size_t k = 0; k < used.size(); k++) if (!used[k]) ids.push_back((int)k); };
+
+	// Cells Encoded Concurrently, Each a Complete Package Of Its Own
+	capture.chunkPackages.resize(chunkCount);
+	capture.chunkIndex.resize(chunkCount);
+	parallel_for(size_t(0), chunkCount, [&](size_t c)
+	{
+		TraceScope trace("chunk", "encode");
+		size_t first = runs[c], last = runs[c + 1];
+
+		// Local Numbering, Sorted Source Ids Double As The Vertex Map, Unset Ids Stay Negative
+		auto localize = [&](const int* source, vector<int>& ids, vector<int>& local)
+		{
+			for (size_t k = first; k < last; k++)
+			{
+				int face = keys[k].second;
+				local.insert(local.end(), source + offsets[face], source + offsets[face + 1]);
+			}
+			for (int id : local) if (id >= 0) ids.push_back(id);
+			sort(ids.begin(), ids.end());
+			ids.erase(unique(ids.begin(), ids.end()), ids.end());
+			for (int& id : local) if (id >= 0) id = (int)(lower_bound(ids.begin(), ids.end(), id) - ids.begin());
+		};
+
+		MeshCapture chunk;
+		MaxMeshMetaData& chunkMeta = chunk.meta;
+		chunkMeta = meshMeta;
+		chunkMeta.topologyHash = chunkMeta.layoutHash = 0;
+		chunkMeta.tNum = chunkMeta.nNum = 0;
+		chunkMeta.fNum = (int)(last - first);
+		for (size_t k = first; k < last; k++)
+		{
+			chunk.degrees.push_back(capture.degrees[keys[k].second]);
+			chunk.faces.push_back(capture.faces[keys[k].second]);
+		}
+
+		vector<int> vertexIds, mapIds, normalIds;
+		bool lastCell = c + 1 == chunkCount;
+		localize(capture.corners.data(), vertexIds, chunk.corners);
+		if (lastCell) loose(referenced, vertexIds);
+		chunkMeta.vNum = (int)vertexIds.size();
+		chunkMeta.cNum = (int)chunk.corners.size();
+		chunkMeta.bounds.Init();
+		for (int id : vertexIds)
+		{
+			chunk.points.push_back(capture.points[id]);
+			chunkMeta.bounds += capture.points[id];
+		}
+
+		if (withMaps)
+		{
+			localize(capture.mapCorners.data(), mapIds, chunk.mapCorners);
+			if (lastCell) loose(mapReferenced, mapIds);
+			for (int id : mapIds) chunk.mapVerts.push_back(mapVerts[id]);
+			chunkMeta.tNum = (int)mapIds.size();
+		}
+		if (withNormals)
+		{
+			localize(capture.normalCorners.data(), normalIds, chunk.normalCorners);
+			if (lastCell) loose(normalReferenced, normalIds);
+			for (int id : normalIds)
+			{
+				chunk.normals.push_back(capture.normals[id]);
+				chunk.normalFlags.push_back(capture.normalFlags[id]);
+			}
+			for (size_t k = first; k < last; k++)
+			{
+				int face = keys[k].second;
+				chunk.cornerFlags.insert(chunk.cornerFlags.end(), capture.cornerFlags.begin() + offsets[face], capture.cornerFlags.begin() + offsets[face + 1]);
+			}
+			chunkMeta.nNum = (int)normalIds.size();
+		}
+
+		chunk.AddChannel("max-mesh.vtx", chunk.points.data(), chunkMeta.vNum);
+		chunk.AddChannel("max-mesh.pdg", chunk.degrees.data(), chunkMeta.fNum);
+		chunk.AddChannel("max-mesh.pvx", chunk.corners.data(), chunkMeta.cNum);
+		chunk.AddChannel("max-mesh.pfd", chunk.faces.data(), chunkMeta.fNum);
+		if (chunkMeta.tNum)
+		{
+			chunk.AddChannel("max-mesh.tex", chunk.mapVerts.data(), chunkMeta.tNum);
+			chunk.AddChannel("max-mesh.ptx", chunk.mapCorners.data(), chunkMeta.cNum);
+			chunk.AddChannel(CHUNK_MAP_ENTRY, mapIds.data(), mapIds.size());
+		}
+		if (chunkMeta.nNum)
+		{
+			chunk.AddChannel("max-mesh.nrm", chunk.normals.data(), chunkMeta.nNum);
+			chunk.AddChannel("max-mesh.pne", chunk.normalFlags.data(), chunkMeta.nNum);
+			chunk.AddChannel("max-mesh.pnx", chunk.normalCorners.data(), chunkMeta.cNum);
+			chunk.AddChannel("max-mesh.pns", chunk.cornerFlags.data(), chunkMeta.cNum);
+			chunk.AddChannel(CHUNK_NORMAL_ENTRY, normalIds.data(), normalIds.size());
+		}
+		chunk.AddChannel(CHUNK_VERTEX_ENTRY, vertexIds.data(), vertexIds.size());
+		chunk.AddChannel("max-mesh.mta", &chunkMeta, 1);
+
+		MaxMeshChunk& record = capture.chunkIndex[c];
+		record = MaxMeshChunk{ keys[first].first, chunkMeta.bounds, chunkMeta.vNum, chunkMeta.fNum, chunkMeta.cNum, chunkMeta.tNum, chunkMeta.nNum, 0 };
+		for (auto& channel : chunk.channels) record.rawSize += channel.size;
+		WriteMeshPackage(chunk, capture.chunkPackages[c]);
+	});
+
+	// Whole Mesh Channels Replaced, Counts Stay Those Of The Source Every Cell Id Indexes Into
+	vector<MeshChannelView> kept;
+	for (auto& channel : capture.channels)
+		if (strcmp(channel.entry, "max-mesh.mta") == 0 || IsLodEntry(channel.entry)) kept.push_back(channel);
+	capture.channels.swap(kept);
+	if (!withMaps) meshMeta.tNum = 0;
+	capture.chunkEntries.resize(chunkCount);
+	for (size_t c = 0; c < chunkCount; c++) capture.chunkEntries[c] = CHUNK_ENTRY_PREFIX + to_string(c);
+	capture.AddChannel(CHUNK_INDEX_ENTRY, capture.chunkIndex.data(), chunkCount);
+	for (size_t c = 0; c < chunkCount; c++)
+		capture.AddChannel(capture.chunkEntries[c].c_str(), capture.chunkPackages[c].data(), capture.chunkPackages[c].size());
+	DebugLog(L"%llu faces split into %llu spatial chunks in %f ms.", (unsigned long long)fNum, (unsigned long long)chunkCount, ElapsedMilliseconds(start));
+}
+
+// Tiered Storage
+string TierKey(const path& package)
+{
+	string key = package.lexically_normal().string(); String2Lower(key);
+	return key;
+}
+bool IsStagingEnabled()
+{
+	return !stagingPath.empty();
+}
+path StagedPackagePath(const path& archivePackage)
+{
+	// Keyed By The Whole Archive Path, Equal Names In Other Folders Never Share a Copy
+	UINT64 hash = 0xCBF29CE484222325ull;
+	for (char c : TierKey(archivePackage)) hash = HashValue(hash, (UINT64)(unsigned char)c);
+	char prefix[24];
+	sprintf_s(prefix, sizeof prefix, "%016llx-", (unsigned long long)hash);
+	return path(stagingPath) / (prefix + archivePackage.filename().string());
+}
+bool IsCurrentStagedCopy(const path& staged, const path& archivePackage)
+{
+	// Written For This Archive, Untouched Since & Not Superseded By a Newer Archive Write
+	StagedOrigin origin;
+	if (!ReadStagedOrigin(staged, origin) || TierKey(origin.archive) != TierKey(archivePackage)) return false;
+	error_code error;
+	auto archived = filesystem::last_write_time(archivePackage, error);
+	return error || (int64_t)archived.time_since_epoch().count() <= origin.stamp;
+}
+bool IsInCacheFolder(const path& archivePackage)
+{
+	string folder = TierKey(path(cachePath) / "");
+	return TierKey(archivePackage).compare(0, folder.size(), folder) == 0;
+}
+void RecordStagedCopy(const path& written, const char* archivePath)
+{
+	if (IsStagingEnabled() && !WriteStagedOrigin(written, path(archivePath)))
+		DebugLog(L"Recording origin of staged package %S failed, it will only be read from the archive.", written.string().c_str());
+}
+path WritablePackagePath(const char* archivePath)
+{
+	// Fastest Writable Tier First, Archive Receives It In The Background
+	if (!IsStagingEnabled()) return path(archivePath);
+	error_code error;
+	filesystem::create_directories(path(stagingPath), error);
+	return StagedPackagePath(archivePath);
+}
+path PartialPackagePath(const path& written)
+{
+	path partial = written;
+	partial += ".part";
+	return partial;
+}
+bool ReplacePackage(const path& partial, const path& written, const char* archivePath)
+{
+	// A Migration Still Copying The Previous Version Lands Before It Is Replaced
+	if (IsStagingEnabled()) migrationQueue.Cancel(path(archivePath));
+
+	error_code error, ignored;
+	filesystem::rename(partial, written, error);
+	if (error) filesystem::remove(partial, ignored);
+	return !error;
+}
+path StorePackageBytes(shared_ptr<Package> package, const char* archivePath)
+{
+	// Written Aside & Renamed, Readers & Migrations Never See a Partial Package
+	path written = WritablePackagePath(archivePath);
+	path partial = PartialPackagePath(written);
+	bool stored = false;
+	{
+		ScopedStage stage(opStats, "write", package->size());
+		ofstream file(partial, ios::binary | ios::trunc);
+		file.write((const char*)package->data(), package->size());
+		file.close();
+		stored = !file.fail();
+	}
+	if (!stored) { error_code error; filesystem::remove(partial, error); }
+	if (!stored || !ReplacePackage(partial, written, archivePath))
+	{
+		memoryTier.Remove(TierKey(archivePath));
+		DebugLog(L"Writing package %S failed.", written.string().c_str());
+		return path();
+	}
+
+	if (memoryTier.Budget()) memoryTier.Put(TierKey(archivePath), move(package));
+	else memoryTier.Remove(TierKey(archivePath));
+
+	RecordStagedCopy(written, archivePath);
+	if (IsStagingEnabled()) migrationQueue.Enqueue(written, path(archivePath));
+	return written;
+}
+path StorePackage(const MeshCapture& capture, const char* archivePath)
+{
+	if (memoryTier.Budget())
+	{
+		auto package = make_shared<Package>();
+		WriteMeshPackage(capture, *package);
+		return StorePackageBytes(move(package), archivePath);
+	}
+
+	path written = WritablePackagePath(archivePath);
+	path partial = PartialPackagePath(written);
+	memoryTier.Remove(TierKey(archivePath));
+	bool stored = true;
+	try { WriteMeshPackage(capture, partial.string().c_str()); }
+	catch (...) { stored = false; }
+	error_code error;
+	stored = stored && filesystem::is_regular_file(partial, error);
+	if (!stored) filesystem::remove(partial, error);
+	if (!stored || !ReplacePackage(partial, written, archivePath))
+	{
+		DebugLog(L"Writing package %S failed.", written.string().c_str());
+		return path();
+	}
+
+	RecordStagedCopy(written, archivePath);
+	if (IsStagingEnabled()) migrationQueue.Enqueue(written, path(archivePath));
+	return written;
+}
+struct PackageReader
+{
+	SharedPackage memory;
+	unique_ptr<RegionInStream> stream;
+	unique_ptr<Unzipper> unzipper;
+	int tier = STORAGE_TIER_ARCHIVE;
+};
+bool ParseMemoryPackage(const string& package, uint64_t& id)
+{
+	size_t prefix = strlen(MEMORY_PACKAGE_PREFIX);
+	if (_strnicmp(package.c_str(), MEMORY_PACKAGE_PREFIX, prefix) != 0) return false;
+	id = strtoull(package.c_str() + prefix, nullptr, 10);
+	return id != 0;
+}
+bool OpenPackage(const string& archivePath, PackageReader& reader)
+{
+	ScopedStage stage(opStats, "open");
+	EnsureCalibration();
+
+	// Memory Checkpoint Or Clipboard, Read In Place
+	uint64_t snapshotId = 0;
+	bool snapshot = ParseMemoryPackage(archivePath, snapshotId);
+	bool clipboard = _stricmp(archivePath.c_str(), CLIPBOARD_PACKAGE_NAME) == 0;
+	if (snapshot || clipboard)
+	{
+		Snapshot found;
+		if (snapshot && memoryCheckpoints.Find(snapshotId, found)) reader.memory = found.package;
+		if (clipboard) reader.memory = clipboardPackage;
+		if (!reader.memory) return false;
+		reader.tier = snapshot ? STORAGE_TIER_SNAPSHOT : STORAGE_TIER_CLIPBOARD;
+		reader.stream = make_unique<RegionInStream>(reader.memory->data(), reader.memory->size());
+		reader.unzipper = make_unique<Unzipper>(*reader.stream);
+		tierReads[reader.tier]++;
+		RecordPackageStats(*reader.unzipper);
+		return true;
+	}
+
+	// Memory Tier, Read In Place
+	reader.memory = memoryTier.Get(TierKey(archivePath));
+	if (reader.memory)
+	{
+		reader.tier = STORAGE_TIER_MEMORY;
+		reader.stream = make_unique<RegionInStream>(reader.memory->data(), reader.memory->size());
+		reader.unzipper = make_unique<Unzipper>(*reader.stream);
+	}
+
+	// Local Staging Copy, Only While It Still Holds What Was Written To This Archive
+	if (!reader.unzipper && IsStagingEnabled())
+	{
+		path staged = StagedPackagePath(archivePath);
+		if (IsCurrentStagedCopy(staged, path(archivePath)))
+		{
+			reader.tier = STORAGE_TIER_STAGING;
+			reader.unzipper = make_unique<Unzipper>(staged.string());
+		}
+	}
+
+	if (!reader.unzipper) reader.unzipper = make_unique<Unzipper>(archivePath);
+	tierReads[reader.tier]++;
+
+	if (reader.tier == STORAGE_TIER_MEMORY) DebugLog(L"Package [%S] read from memory tier.", archivePath.c_str());
+	if (reader.tier == STORAGE_TIER_STAGING) DebugLog(L"Package [%S] read from staging tier.", archivePath.c_str());
+	RecordPackageStats(*reader.unzipper);
+	return true;
+}
+int FindLodLevel(Unzipper& unzipper, int lod)
+{
+	// Coarsest Stored Level Up To The One Asked For, Zero When None Were Cached
+	int level = 0;
+	for (auto& entry : unzipper.entries())
+		for (int l = 1; l <= min(lod, MAX_LOD_LEVELS); l++)
+			if (entry.name == LodEntry(l)) level = max(level, l);
+	return level;
+}
+bool OpenPackage(const string& archivePath, int lod, PackageReader& reader)
+{
+	if (!OpenPackage(archivePath, reader)) return false;
+	if (lod <= 0) return true;
+
+	int level = FindLodLevel(*reader.unzipper, lod);
+	if (!level)
+	{
+		DebugLog(L"Package [%S] carries no LOD levels, restoring the full mesh.", archivePath.c_str());
+		return true;
+	}
+
+	// Only The Level Is Inflated, The Full Mesh Channels Are Never Read
+	auto package = make_shared<Package>();
+	bool extracted = false;
+	{
+		ScopedStage stage(opStats, "inflate");
+		extracted = reader.unzipper->extractEntryToMemory(LodEntry(level), *package);
+		stage.AddBytes(package->size());
+	}
+	reader.unzipper->close();
+	reader.unzipper.reset();
+	if (!extracted) return false;
+
+	reader.memory = package;
+	reader.stream = make_unique<RegionInStream>(reader.memory->data(), reader.memory->size());
+	reader.unzipper = make_unique<Unzipper>(*reader.stream);
+	DebugLog(L"Package [%S] read at LOD %d.", archivePath.c_str(), level);
+	return true;
+}
+void RemovePackageTiers(const path& archivePackage)
+{
+	error_code error;
+	migrationQueue.Cancel(archivePackage);
+	memoryTier.Remove(TierKey(archivePackage));
+	if (!IsStagingEnabled()) return;
+	path staged = StagedPackagePath(archivePackage);
+	filesystem::remove(staged, error);
+	filesystem::remove(StagedOriginPath(staged), error);
+}
+void RecoverStagedPackages()
+{
+	// Staged Copies Newer Than Their Archive Were Never Migrated, e.g. After a Crash
+	// Each Goes Back To The Archive It Was Written For, Copies Without a Valid Origin Are Left Alone
+	error_code error;
+	for (auto& entry : directory_iterator(path(stagingPath), error))
+	{
+		string ext = entry.path().extension().string(); String2Lower(ext);
+		if (!entry.is_regular_file() || ext != ".mxo") continue;
+
+		StagedOrigin origin;
+		if (!ReadStagedOrigin(entry.path(), origin))
+		{
+			DebugLog(L"Skipping staged package [%S], its origin is unknown or it changed since.", entry.path().filename().string().c_str());
+			continue;
+		}
+		path archive = origin.archive;
+		error_code archiveError;
+		auto archived = filesystem::last_write_time(archive, archiveError);
+		if (archiveError || (int64_t)archived.time_since_epoch().count() < origin.stamp)
+		{
+			DebugLog(L"Resuming migration of staged package [%S].", entry.path().filename().string().c_str());
+			migrationQueue.Enqueue(entry.path(), archive);
+		}
+	}
+}
+bool CacheMeshToDisk(INode* node, bool checkpoint = false)
+{
+	char outputNameBuffer[MAX_PATH];
+
+	if (!node) { return false; }
+	ScopedOperation operation(opStats, checkpoint ? "checkpoint" : "cache", StatsTarget(node).c_str());
+	DebugLog(L"Caching object [%s] mesh buffer...", node->GetName());
+
+	if (cacheBufferingMode == DISK_CACHE_BUFFERING_MODE)
+		DebugLog(L"Config `Cache Buffering Mode` = DISK_CACHE_BUFFERING_MODE");
+	if (cacheBufferingMode == MEMORY_CACHE_BUFFERING_MODE)
+		DebugLog(L"Config `Cache Buffering Mode` = MEMORY_CACHE_BUFFERING_MODE");
+
+	profiler.Reset(); profiler.Start();
+
+	TimeValue t = GetCOREInterface()->GetTime();
+	MeshCapture capture;
+	capture.reorder = cacheReorder;
+
+	if (CaptureMesh(node, t, capture))
+	{
+		// Simplified Levels & Spatial Chunks Travel In The Same Package
+		BuildLodPackages(capture);
+		BuildChunkPackages(capture);
+
+		// Packaging
+		sprintf_s(outputNameBuffer, sizeof outputNameBuffer, "%s\\%S.mxo", cachePath.c_str(), node->GetName());
+		if (checkpoint) sprintf_s(outputNameBuffer, sizeof outputNameBuffer, "%s\\%S-%s.mxo", cachePath.c_str(), node->GetName(), gtfrmtt());
+
+		// Compressing
+		path writtenPath = StorePackage(capture, _strlwr(outputNameBuffer));
+		if (writtenPath.empty())
+		{
+			DebugLog(L"Caching object [%s] failed, package could not be written.", node->GetName());
+			return false;
+		}
+		CatalogPackage(capture, outputNameBuffer, writtenPath);
+		RecordPackageStats(writtenPath);
+
+		DebugLog(L"Object [%s] successfully cached to %S in %f ms", node->GetName(), outputNameBuffer, profiler.ElapsedMilliseconds());
+		operation.Succeed();
+		return true;
+	}
+
+	DebugLog(L"Caching object [%s] failed.", node->GetName());
+	return false;
+}
+
+// Memory Accounting
+bool IsMemoryGranted(const ScopedCharge& charge, const wchar_t* purpose)
+{
+	if (charge.Granted()) return true;
+	DebugLog(L"Operation memory limit of %llu MB reached, %s refused.", (unsigned long long)(memoryLedger.OperationLimit() >> 20), purpose);
+	return false;
+}
+bool AcquireStaging(BUFFER& buffer, size_t size)
+{
+	// Charged By Capacity, Pooled Buffers May Be Larger Than Asked For
+	buffer = bufferPool.Acquire(size);
+	if (memoryLedger.Charge(LedgerStaging, buffer.capacity())) return true;
+	bufferPool.Release(buffer);
+	DebugLog(L"Operation memory limit of %llu MB reached, staging buffer of %llu KB refused.",
+		(unsigned long long)(memoryLedger.OperationLimit() >> 20), (unsigned long long)(size >> 10));
+	return false;
+}
+void ReleaseStaging(BUFFER& buffer)
+{
+	memoryLedger.Credit(LedgerStaging, buffer.capacity());
+	bufferPool.Release(buffer);
+}
+uint64_t TriMeshBytes(const MaxMeshMetaData& meshMeta)
+{
+	return (uint64_t)meshMeta.vNum * sizeof(Point3) + (uint64_t)meshMeta.nNum * sizeof(Point3) + (uint64_t)meshMeta.tNum * sizeof(UVVert) +
+		(uint64_t)meshMeta.fNum * (sizeof(Face) + sizeof(TVFace) + sizeof(MeshNormalFace));
+}
+uint64_t PolyMeshBytes(const MaxMeshMetaData& meshMeta)
+{
+	// Corners Carry Vertex, Edge, Map & Normal Indices, Manifold Meshes Hold About Half As Many Edges
+	uint64_t cornerChannels = 2 + (meshMeta.tNum ? 1 : 0) + (meshMeta.nNum ? 1 : 0);
+	return (uint64_t)meshMeta.vNum * sizeof(MNVert) + (uint64_t)meshMeta.fNum * sizeof(MNFace) + (uint64_t)meshMeta.cNum / 2 * sizeof(MNEdge) +
+		(uint64_t)meshMeta.cNum * cornerChannels * sizeof(int) + (uint64_t)meshMeta.tNum * sizeof(UVVert) + (uint64_t)meshMeta.nNum * sizeof(Point3);
+}
+uint64_t PolyMeshBytes(const MNMesh& mesh)
+{
+	return (uint64_t)mesh.numv * sizeof(MNVert) + (uint64_t)mesh.nume * sizeof(MNEdge) + (uint64_t)mesh.numf * sizeof(MNFace);
+}
+void LogOperationMemory(const OperationReport& report)
+{
+	if (!DebugMode || report.memory.empty()) return;
+	LedgerStats ledger = memoryLedger.Stats();
+	DebugLog(L"Operation [%S] memory : peak %llu KB, staging %llu KB, mesh %llu KB, undo %llu KB (%llu KB retained), plugin total %llu KB of %llu KB peak.",
+		report.kind.c_str(), (unsigned long long)(report.peakMemory >> 10),
+		(unsigned long long)(report.memory[LedgerStaging].peakBytes >> 10),
+		(unsigned long long)(report.memory[LedgerMeshes].peakBytes >> 10),
+		(unsigned long long)(report.memory[LedgerUndo].peakBytes >> 10),
+		(unsigned long long)(report.memory[LedgerUndo].retainedBytes >> 10),
+		(unsigned long long)(ledger.current >> 10), (unsigned long long)(ledger.peak >> 10));
+}
+
+// Restore Pipeline
+template<typename T> void CopyChannel(T* target, const BUFFER& buffer, size_t count)
+{
+	size_t bytes = min(count, buffer.size() / sizeof(T)) * sizeof(T);
+
+	if (IsParallelRestore(bytes))
+		ParallelCopy(target, buffer.data(), bytes, copyCalibration);
+	else
+		memcpy(target, buffer.data(), bytes);
+}
+template<typename T> bool RestoreChannel(Unzipper& unzipper, const char* entry, T* target, size_t count, bool streamed)
+{
+	if (count == 0) return true;
+
+	// Inflate Straight Into Target
+	TraceScope trace("inflate", "channel", entry);
+	auto start = chrono::steady_clock::now();
+	if (streamed)
+	{
+		RegionOutStream stream(target, count * sizeof(T));
+		unzipper.extractEntryToStream(entry, stream);
+		double inflated = ElapsedMilliseconds(start);
+		opStats.AddStage("inflate", inflated, count * sizeof(T));
+		opStats.AddChannel(entry, 0, 0, inflated);
+		return stream.Complete();
+	}
+
+	// Inflate, Consume, Release
+	BUFFER buffer;
+	if (!AcquireStaging(buffer, count * sizeof(T))) return false;
+	bool extracted = unzipper.extractEntryToMemory(entry, buffer);
+	double inflated = ElapsedMilliseconds(start);
+	opStats.AddStage("inflate", inflated, count * sizeof(T));
+	opStats.AddChannel(entry, 0, 0, inflated);
+	if (!extracted) { BUFFER_FREE(buffer); return false; }
+	{
+		ScopedStage stage(opStats, "copy", count * sizeof(T));
+		CopyChannel(target, buffer, count);
+	}
+	BUFFER_FREE(buffer);
+	return true;
+}
+bool ExtractChannel(Unzipper& unzipper, const char* entry, BUFFER& buffer, size_t size)
+{
+	if (size == 0) return true;
+	BUFFER_FREE(buffer);
+	if (!AcquireStaging(buffer, size)) return false;
+	TraceScope trace("inflate", "channel", entry);
+	auto start = chrono::steady_clock::now();
+	bool extracted = unzipper.extractEntryToMemory(entry, buffer) && buffer.size() >= size;
+	double inflated = ElapsedMilliseconds(start);
+	opStats.AddStage("inflate", inflated, size);
+	opStats.AddChannel(entry, 0, 0, inflated);
+	return extracted;
+}
+bool ReadMetaFromCache(Unzipper& unzipper, MaxMeshMetaData& meshMeta)
+{
+	BUFFER mta_buffer;
+	memset(&meshMeta, 0, sizeof(MaxMeshMetaData));
+	unzipper.extractEntryToMemory("max-mesh.mta", mta_buffer);
+	if (mta_buffer.size() < LEGACY_META_DATA_SIZE) return false;
+	memcpy(&meshMeta, mta_buffer.data(), min(mta_buffer.size(), sizeof(MaxMeshMetaData)));
 	return true;
 }
-string GetStorageFilePath()
+MaxMeshMetaData SelectChannels(const MaxMeshMetaData& meshMeta, BYTE channels)
+{
+	// Unselected Channels Look Absent, Their Entries Are Never Inflated
+	MaxMeshMetaData selected = meshMeta;
+	if (!(channels & RESTORE_CHANNEL_UVS)) selected.tNum = 0;
+	if (!(channels & RESTORE_CHANNEL_NORMALS)) selected.nNum = 0;
+	return selected;
+}
+bool IsSelectedChannel(const string& entry, const MaxMeshMetaData& meshMeta)
+{
+	static const char* uvEntries[] = { "max-mesh.tex", "max-mesh.tdx", "max-mesh.ptx" };
+	static const char* normalEntries[] = { "max-mesh.nrm", "max-mesh.ndx", "max-mesh.pne", "max-mesh.pnx", "max-mesh.pns" };
+	if (!meshMeta.tNum) for (auto name : uvEntries) if (entry == name) return false;
+	if (!meshMeta.nNum) for (auto name : normalEntries) if (entry == name) return false;
+	return true;
+}
+bool IsStreamedRestore(Unzipper& unzipper, const MaxMeshMetaData& meshMeta)
+{
+	// Peak Memory Estimation, Staging Holds One Channel At a Time
+	size_t meshBytes = 0, largestChannel = 0;
+	for (auto& entry : unzipper.entries())
+	{
+		if (entry.name == "max-mesh.mta" || IsLodEntry(entry.name) || !IsSelectedChannel(entry.name, meshMeta)) continue;
+		meshBytes += (size_t)entry.uncompressedSize;
+		largestChannel = max(largestChannel, (size_t)entry.uncompressedSize);
+	}
+	// Operation Limit Counts Too, Streaming Avoids The Staging Charges Entirely
+	size_t limit = restoreMemoryLimit;
+	size_t operationLimit = (size_t)memoryLedger.OperationLimit();
+	if (operationLimit && (!limit || operationLimit < limit)) limit = operationLimit;
+	bool streamed = limit && (meshBytes + largestChannel) > limit;
+
+	if (streamed)
+		DebugLog(L"Estimated peak of %llu MB exceeds restore memory limit, streaming channels into mesh.",
+			(unsigned long long)((meshBytes + largestChannel) >> 20));
+
+	return streamed;
+}
+bool DecodeMeshMap(Unzipper& unzipper, const MaxMeshMetaData& meshMeta, Mesh& mesh, bool streamed)
+{
+	// Face Indices Only Exist Alongside Their Vertices
+	mesh.setNumTVerts(meshMeta.tNum);
+	mesh.setNumTVFaces(meshMeta.tNum ? meshMeta.fNum : 0);
+	if (!meshMeta.tNum) return true;
+	return
+		RestoreChannel(unzipper, "max-mesh.tex", mesh.tVerts, meshMeta.tNum, streamed) &&
+		RestoreChannel(unzipper, "max-mesh.tdx", mesh.tvFace, meshMeta.fNum, streamed);
+}
+bool DecodeMeshNormals(Unzipper& unzipper, const MaxMeshMetaData& meshMeta, Mesh& mesh, bool streamed)
+{
+	if (!meshMeta.nNum) return true;
+	mesh.SpecifyNormals();
+	MeshNormalSpec* mesh_ns = mesh.GetSpecifiedNormals();
+	mesh_ns->SetNumNormals(meshMeta.nNum);
+	mesh_ns->SetNumFaces(meshMeta.fNum);
+	return
+		RestoreChannel(unzipper, "max-mesh.nrm", mesh_ns->GetNormalArray(), meshMeta.nNum, streamed) &&
+		RestoreChannel(unzipper, "max-mesh.ndx", mesh_ns->GetFaceArray(), meshMeta.fNum, streamed);
+}
+bool DecodeMeshFromCache(Unzipper& unzipper, const MaxMeshMetaData& meshMeta, Mesh& mesh)
+{
+	bool streamed = IsStreamedRestore(unzipper, meshMeta);
+
+	// Allocate Sizes
+	mesh.setNumVerts(meshMeta.vNum);
+	mesh.setNumFaces(meshMeta.fNum);
+
+	// Restore Channels In Sequence
+	return
+		RestoreChannel(unzipper, "max-mesh.vtx", mesh.verts, meshMeta.vNum, streamed) &&
+		RestoreChannel(unzipper, "max-mesh.idx", mesh.faces, meshMeta.fNum, streamed) &&
+		DecodeMeshMap(unzipper, meshMeta, mesh, streamed) &&
+		DecodeMeshNormals(unzipper, meshMeta, mesh, streamed);
+}
+bool ExtractBlockChannel(Unzipper& block, const char* entry, BUFFER& buffer, size_t size)
+{
+	// Staged Against The Caller's Charge, Released Straight To The Pool
+	if (size == 0) return true;
+	buffer = bufferPool.Acquire(size);
+	return block.extractEntryToMemory(entry, buffer) && buffer.size() >= size;
+}
+bool IsChunkedPackage(Unzipper& unzipper)
+{
+	for (auto& entry : unzipper.entries()) if (entry.name == CHUNK_INDEX_ENTRY) return true;
+	return false;
+}
+bool ReadChunkIndex(Unzipper& unzipper, vector<MaxMeshChunk>& chunks)
+{
+	Package index;
+	if (!unzipper.extractEntryToMemory(CHUNK_INDEX_ENTRY, index) || index.size() % sizeof(MaxMeshChunk)) return false;
+	chunks.resize(index.size() / sizeof(MaxMeshChunk));
+	memcpy(chunks.data(), index.data(), index.size());
+	return true;
+}
+bool BoundsOverlap(const Box3& a, const Box3& b)
+{
+	return a.pmin.x <= b.pmax.x && a.pmax.x >= b.pmin.x && a.pmin.y <= b.pmax.y && a.pmax.y >= b.pmin.y && a.pmin.z <= b.pmax.z && a.pmax.z >= b.pmin.z;
+}
+vector<size_t> SelectChunks(const vector<MaxMeshChunk>& chunks, const Box3* region)
+{
+	vector<size_t> selected;
+	for (size_t c = 0; c < chunks.size(); c++) if (!region || BoundsOverlap(chunks[c].bounds, *region)) selected.push_back(c);
+	return selected;
+}
+bool DecodeChunkedPoly(Unzipper& unzipper, const MaxMeshMetaData& meshMeta, MNMesh& mesh, const Box3* region = nullptr)
+{
+	// meshMeta Is The Header Of The Whole Package, Cell Vertex Ids Index Into Its vNum
+	vector<MaxMeshChunk> index;
+	if (!ReadChunkIndex(unzipper, index)) return false;
+
+	// Cells Outside The Region Are Never Extracted, Stored Blocks Are Copied Out In Turn
+	vector<size_t> selected = SelectChunks(index, region);
+	size_t count = selected.size();
+
+	// Pool Threads Stage Every Block At Once, Charged Here On The Operation Thread
+	uint64_t blockBytes = 0;
+	for (size_t c : selected) blockBytes += index[c].rawSize * 2;
+	ScopedCharge blockCharge(memoryLedger, LedgerStaging, blockBytes);
+	if (!IsMemoryGranted(blockCharge, L"chunk staging")) return false;
+
+	vector<Package> blocks(count);
+	{
+		ScopedStage stage(opStats, "extract");
+		for (size_t s = 0; s < count; s++)
+			if (!unzipper.extractEntryToMemory(CHUNK_ENTRY_PREFIX + to_string(selected[s]), blocks[s])) return false;
+	}
+
+	// Bases Of Every Block In The Target Mesh, Unselected Channels Left Out
+	bool withMaps = false, withNormals = false;
+	vector<size_t> faceBase(count + 1, 0);
+	for (size_t s = 0; s < count; s++)
+	{
+		const MaxMeshChunk& chunk = index[selected[s]];
+		faceBase[s + 1] = faceBase[s] + chunk.fNum;
+		withMaps = withMaps || (meshMeta.tNum && chunk.tNum);
+		withNormals = withNormals || (meshMeta.nNum && chunk.nNum);
+	}
+
+	// Id Maps & Shared Vertices, Blocks Inflated Concurrently
+	vector<BUFFER> ids(count), points(count), mapIds(count), mapVerts(count), normalIds(count), normals(count), explicits(count);
+	auto release = [&]()
+	{
+		for (size_t s = 0; s < count; s++)
+			for (BUFFER* buffer : { &ids[s], &points[s], &mapIds[s], &mapVerts[s], &normalIds[s], &normals[s], &explicits[s] }) bufferPool.Release(*buffer);
+	};
+	atomic<bool> valid = true;
+	parallel_for(size_t(0), count, [&](size_t s)
+	{
+		TraceScope trace("chunk", "decode");
+		const MaxMeshChunk& chunk = index[selected[s]];
+		RegionInStream stream(blocks[s].data(), blocks[s].size());
+		Unzipper block(stream);
+		if (!ExtractBlockChannel(block, CHUNK_VERTEX_ENTRY, ids[s], chunk.vNum * sizeof(int)) ||
+			!ExtractBlockChannel(block, "max-mesh.vtx", points[s], chunk.vNum * sizeof(Point3))) valid = false;
+		if (withMaps && chunk.tNum &&
+			(!ExtractBlockChannel(block, CHUNK_MAP_ENTRY, mapIds[s], chunk.tNum * sizeof(int)) ||
+			!ExtractBlockChannel(block, "max-mesh.tex", mapVerts[s], chunk.tNum * sizeof(UVVert)))) valid = false;
+		if (withNormals && chunk.nNum &&
+			(!ExtractBlockChannel(block, CHUNK_NORMAL_ENTRY, normalIds[s], chunk.nNum * sizeof(int)) ||
+			!ExtractBlockChannel(block, "max-mesh.nrm", normals[s], chunk.nNum * sizeof(Point3)) ||
+			!ExtractBlockChannel(block, "max-mesh.pne", explicits[s], chunk.nNum))) valid = false;
+		block.close();
+	});
+	if (!valid) { release(); return false; }
+
+	// Numbering, The Whole Mesh Keeps Its Own, a Region Is Compacted In Cell Order, Shared Ids Keep Their First Copy
+	auto number = [&](const vector<BUFFER>& chunkIds, int total, int MaxMeshChunk::* local, vector<int>& remap, vector<pair<size_t, int>>& sources)
+	{
+		remap.assign(total, -1);
+		sources.assign(region ? 0 : total, make_pair(count, 0));
+		for (size_t s = 0; s < count; s++)
+		{
+			const int* blockIds = (const int*)chunkIds[s].data();
+			for (int k = 0; k < index[selected[s]].*local && blockIds; k++)
+			{
+				int id = blockIds[k];
+				if (id < 0 || id >= total) return false;
+				if (remap[id] >= 0) continue;
+				remap[id] = region ? (int)sources.size() : id;
+				if (region) sources.push_back(make_pair(s, k));
+				else sources[id] = make_pair(s, k);
+			}
+		}
+		return true;
+	};
+	vector<int> remap, mapRemap, normalRemap;
+	vector<pair<size_t, int>> sources, mapSources, normalSources;
+	if (!number(ids, meshMeta.vNum, &MaxMeshChunk::vNum, remap, sources) ||
+		(withMaps && !number(mapIds, meshMeta.tNum, &MaxMeshChunk::tNum, mapRemap, mapSources)) ||
+		(withNormals && !number(normalIds, meshMeta.nNum, &MaxMeshChunk::nNum, normalRemap, normalSources))) { release(); return false; }
+
+	// Allocate Sizes
+	size_t vNum = sources.size(), fNum = faceBase[count];
+	mesh.ClearAndFree();
+	mesh.setNumVerts((int)vNum);
+	mesh.setNumFaces((int)fNum);
+	RestoreLoop(vNum, vNum * sizeof(Point3), [&](size_t i)
+	{
+		const pair<size_t, int>& source = sources[i];
+		mesh.v[i].p = source.first < count ? ((const Point3*)points[source.first].data())[source.second] : Point3(0.0f, 0.0f, 0.0f);
+	});
+
+	// Faces
+	parallel_for(size_t(0), count, [&](size_t s)
+	{
+		TraceScope trace("chunk", "faces");
+		const MaxMeshChunk& chunk = index[selected[s]];
+		RegionInStream stream(blocks[s].data(), blocks[s].size());
+		Unzipper block(stream);
+		BUFFER degrees, corners, faces;
+		if (ExtractBlockChannel(block, "max-mesh.pdg", degrees, chunk.fNum * sizeof(int)) &&
+			ExtractBlockChannel(block, "max-mesh.pvx", corners, chunk.cNum * sizeof(int)) &&
+			ExtractBlockChannel(block, "max-mesh.pfd", faces, chunk.fNum * sizeof(MaxMeshPolyFace)))
+		{
+			const int* chunkIds = (const int*)ids[s].data();
+			const int* chunkDegrees = (const int*)degrees.data();
+			const int* chunkCorners = (const int*)corners.data();
+			const MaxMeshPolyFace* chunkFaces = (const MaxMeshPolyFace*)faces.data();
+			size_t offset = 0;
+			for (int f = 0; f < chunk.fNum && valid; f++)
+			{
+				if (offset + chunkDegrees[f] > (size_t)chunk.cNum) { valid = false; break; }
+				MNFace* face = mesh.F((int)(faceBase[s] + f));
+				face->SetDeg(chunkDegrees[f]);
+				for (int j = 0; j < chunkDegrees[f]; j++)
+				{
+					int local = chunkCorners[offset + j];
+					if (local < 0 || local >= chunk.vNum) { valid = false; local = 0; }
+					face->vtx[j] = remap[chunkIds[local]];
+				}
+				face->smGroup = chunkFaces[f].smGroup;
+				face->material = chunkFaces[f].material;
+				offset += chunkDegrees[f];
+			}
+		}
+		else valid = false;
+		bufferPool.Release(degrees); bufferPool.Release(corners); bufferPool.Release(faces);
+		block.close();
+	});
+	if (!valid) { release(); return false; }
+
+	// Build Edges & Vertex Adjacency
+	{
+		ScopedStage stage(opStats, "fillInMesh");
+		mesh.FillInMesh();
+	}
+
+	// Texture Map Channel & Specified Normals, Shared Vertices Written Once
+	mesh.SetMapNum(2);
+	mesh.M(0)->SetFlag(MN_DEAD);
+	mesh.M(1)->SetFlag(MN_DEAD);
+	MNMap* map = mesh.M(1);
+	if (withMaps)
+	{
+		map->ClearFlag(MN_DEAD);
+		map->setNumVerts((int)mapSources.size());
+		map->setNumFaces((int)fNum);
+		for (size_t k = 0; k < mapSources.size(); k++)
+		{
+			const pair<size_t, int>& source = mapSources[k];
+			map->v[k] = source.first < count ? ((const UVVert*)mapVerts[source.first].data())[source.second] : UVVert(0.0f, 0.0f, 0.0f);
+		}
+	}
+	MNNormalSpec* mesh_ns = nullptr;
+	if (withNormals)
+	{
+		mesh.SpecifyNormals();
+		mesh_ns = mesh.GetSpecifiedNormals();
+		mesh_ns->SetParent(&mesh);
+		mesh_ns->SetNumFaces((int)fNum);
+		mesh_ns->SetNumNormals((int)normalSources.size());
+		for (size_t k = 0; k < normalSources.size(); k++)
+		{
+			const pair<size_t, int>& source = normalSources[k];
+			bool known = source.first < count;
+			mesh_ns->Normal((int)k) = known ? ((const Point3*)normals[source.first].data())[source.second] : Point3(0.0f, 0.0f, 0.0f);
+			mesh_ns->SetNormalExplicit((int)k, known && explicits[source.first][source.second] != 0);
+		}
+	}
+	if (withMaps || withNormals) parallel_for(size_t(0), count, [&](size_t s)
+	{
+		TraceScope trace("chunk", "maps");
+		const MaxMeshChunk& chunk = index[selected[s]];
+		RegionInStream stream(blocks[s].data(), blocks[s].size());
+		Unzipper block(stream);
+		BUFFER buffer, flags;
+		vector<size_t> offsets(chunk.fNum + 1, 0);
+		for (int f = 0; f < chunk.fNum; f++) offsets[f + 1] = offsets[f] + mesh.f[faceBase[s] + f].deg;
+
+		if (withMaps && chunk.tNum)
+		{
+			if (ExtractBlockChannel(block, "max-mesh.ptx", buffer, chunk.cNum * sizeof(int)))
+			{
+				const int* chunkIds = (const int*)mapIds[s].data();
+				const int* mapCorners = (const int*)buffer.data();
+				for (int f = 0; f < chunk.fNum; f++)
+				{
+					MNMapFace& mapFace = map->f[faceBase[s] + f];
+					mapFace.SetSize((int)(offsets[f + 1] - offsets[f]));
+					for (size_t j = offsets[f]; j < offsets[f + 1]; j++)
+					{
+						int local = mapCorners[j];
+						if (local < 0 || local >= chunk.tNum) { valid = false; local = 0; }
+						mapFace.tv[j - offsets[f]] = mapRemap[chunkIds[local]];
+					}
+				}
+			}
+			else valid = false;
+			bufferPool.Release(buffer);
+		}
+		else if (withMaps)
+			for (int f = 0; f < chunk.fNum; f++)
+			{
+				MNMapFace& mapFace = map->f[faceBase[s] + f];
+				mapFace.SetSize((int)(offsets[f + 1] - offsets[f]));
+				for (int j = 0; j < mapFace.deg; j++) mapFace.tv[j] = 0;
+			}
+
+		if (withNormals && chunk.nNum)
+		{
+			if (ExtractBlockChannel(block, "max-mesh.pnx", buffer, chunk.cNum * sizeof(int)) &&
+				ExtractBlockChannel(block, "max-mesh.pns", flags, chunk.cNum))
+			{
+				const int* chunkIds = (const int*)normalIds[s].data();
+				const int* normalCorners = (const int*)buffer.data();
+				for (int f = 0; f < chunk.fNum; f++)
+				{
+					MNNormalFace& normalFace = mesh_ns->Face((int)(faceBase[s] + f));
+					normalFace.SetDegree((int)(offsets[f + 1] - offsets[f]));
+					for (size_t j = offsets[f]; j < offsets[f + 1]; j++)
+					{
+						int local = normalCorners[j];
+						if (local >= chunk.nNum) { valid = false; local = -1; }
+						normalFace.SetNormalID((int)(j - offsets[f]), local < 0 ? -1 : normalRemap[chunkIds[local]]);
+						normalFace.SetSpecified((int)(j - offsets[f]), flags[j] != 0);
+					}
+				}
+			}
+			else valid = false;
+			bufferPool.Release(buffer); bufferPool.Release(flags);
+		}
+		else if (withNormals)
+			for (int f = 0; f < chunk.fNum; f++)
+			{
+				MNNormalFace& normalFace = mesh_ns->Face((int)(faceBase[s] + f));
+				normalFace.SetDegree((int)(offsets[f + 1] - offsets[f]));
+				for (int j = 0; j < normalFace.GetDegree(); j++) normalFace.SetNormalID(j, -1);
+			}
+		block.close();
+	});
+	release();
+	if (!valid) return false;
+
+	if (withNormals)
+	{
+		mesh_ns->SetFlag(MNNORMAL_NORMALS_BUILT);
+		mesh_ns->SetFlag(MNNORMAL_NORMALS_COMPUTED);
+	}
+
+	mesh.InvalidateGeomCache();
+	mesh.InvalidateTopoCache();
+	return true;
+}
+bool DecodePolyMap(Unzipper& unzipper, const MaxMeshMetaData& meshMeta, const int* degrees, const vector<size_t>& offsets, MNMesh& mesh, bool streamed)
+{
+	if (!meshMeta.tNum) return true;
+	size_t fNum = meshMeta.fNum, cNum = meshMeta.cNum;
+	BUFFER buffer;
+
+	MNMap* map = mesh.M(1);
+	map->ClearFlag(MN_DEAD);
+	map->setNumVerts(meshMeta.tNum);
+	map->setNumFaces((int)fNum);
+	if (!RestoreChannel(unzipper, "max-mesh.tex", map->v, meshMeta.tNum, streamed)) return false;
+	if (!ExtractChannel(unzipper, "max-mesh.ptx", buffer, cNum * sizeof(int))) return false;
+	const int* mapCorners = (const int*)buffer.data();
+	atomic<bool> valid = true;
+	RestoreLoop(fNum, cNum * sizeof(int), [&](size_t i) {
+		map->f[i].SetSize(degrees[i]);
+		for (int j = 0; j < degrees[i]; j++)
+		{
+			int mapVertex = mapCorners[offsets[i] + j];
+			if (mapVertex < 0 || mapVertex >= meshMeta.tNum) { valid = false; mapVertex = 0; }
+			map->f[i].tv[j] = mapVertex;
+		}
+	});
+	BUFFER_FREE(buffer);
+	return valid;
+}
+bool DecodePolyNormals(Unzipper& unzipper, const MaxMeshMetaData& meshMeta, const int* degrees, const vector<size_t>& offsets, MNMesh& mesh, bool streamed)
+{
+	if (!meshMeta.nNum) return true;
+	size_t fNum = meshMeta.fNum, cNum = meshMeta.cNum;
+	BUFFER buffer, flags;
+
+	mesh.SpecifyNormals();
+	MNNormalSpec* mesh_ns = mesh.GetSpecifiedNormals();
+	mesh_ns->SetParent(&mesh);
+	mesh_ns->SetNumFaces((int)fNum);
+	mesh_ns->SetNumNormals(meshMeta.nNum);
+
+	if (!ExtractChannel(unzipper, "max-mesh.nrm", buffer, meshMeta.nNum * sizeof(Point3))) return false;
+	if (!ExtractChannel(unzipper, "max-mesh.pne", flags, meshMeta.nNum)) return false;
+	const Point3* normals = (const Point3*)buffer.data();
+	RestoreLoop(meshMeta.nNum, meshMeta.nNum * sizeof(Point3), [&](size_t i) { mesh_ns->Normal((int)i) = normals[i]; });
+	for (int i = 0; i < meshMeta.nNum; i++) mesh_ns->SetNormalExplicit(i, flags[i] != 0);
+	BUFFER_FREE(buffer); BUFFER_FREE(flags);
+
+	if (!ExtractChannel(unzipper, "max-mesh.pnx", buffer, cNum * sizeof(int))) return false;
+	if (!ExtractChannel(unzipper, "max-mesh.pns", flags, cNum)) return false;
+	const int* normalCorners = (const int*)buffer.data();
+	atomic<bool> valid = true;
+	RestoreLoop(fNum, cNum * sizeof(int), [&](size_t i) {
+		MNNormalFace& normalFace = mesh_ns->Face((int)i);
+		normalFace.SetDegree(degrees[i]);
+		for (int j = 0; j < degrees[i]; j++)
+		{
+			// Unset Corners Stay -1
+			int normal = normalCorners[offsets[i] + j];
+			if (normal < -1 || normal >= meshMeta.nNum) { valid = false; normal = -1; }
+			normalFace.SetNormalID(j, normal);
+			normalFace.SetSpecified(j, flags[offsets[i] + j] != 0);
+		}
+	});
+	BUFFER_FREE(buffer); BUFFER_FREE(flags);
+	if (!valid) return false;
+
+	mesh_ns->SetFlag(MNNORMAL_NORMALS_BUILT);
+	mesh_ns->SetFlag(MNNORMAL_NORMALS_COMPUTED);
+	return true;
+}
+bool DecodePolyFromCache(Unzipper& unzipper, const MaxMeshMetaData& meshMeta, MNMesh& mesh)
+{
+	// Spatially Chunked Packages Carry No Whole Mesh Channels
+	if (IsChunkedPackage(unzipper)) return DecodeChunkedPoly(unzipper, meshMeta, mesh);
+
+	bool streamed = IsStreamedRestore(unzipper, meshMeta);
+	size_t vNum = meshMeta.vNum, fNum = meshMeta.fNum, cNum = meshMeta.cNum;
+	BUFFER pdg_buffer, buffer, flags;
+
+	// Polygon Degrees & Corner Offsets
+	if (!ExtractChannel(unzipper, "max-mesh.pdg", pdg_buffer, fNum * sizeof(int))) return false;
+	const int* degrees = (const int*)pdg_buffer.data();
+	vector<size_t> offsets(fNum + 1, 0);
+	for (size_t i = 0; i < fNum; i++)
+	{
+		if (degrees[i] < 0 || (size_t)degrees[i] > cNum) { BUFFER_FREE(pdg_buffer); return false; }
+		offsets[i + 1] = offsets[i] + degrees[i];
+	}
+	if (offsets[fNum] != cNum) { BUFFER_FREE(pdg_buffer); return false; }
+
+	// Allocate Sizes
+	mesh.ClearAndFree();
+	mesh.setNumVerts((int)vNum);
+	mesh.setNumFaces((int)fNum);
+
+	// Vertices
+	if (!ExtractChannel(unzipper, "max-mesh.vtx", buffer, vNum * sizeof(Point3))) return false;
+	const Point3* points = (const Point3*)buffer.data();
+	RestoreLoop(vNum, vNum * sizeof(Point3), [&](size_t i) { mesh.v[i].p = points[i]; });
+	BUFFER_FREE(buffer);
+
+	// Faces
+	if (!ExtractChannel(unzipper, "max-mesh.pvx", buffer, cNum * sizeof(int))) return false;
+	if (!ExtractChannel(unzipper, "max-mesh.pfd", flags, fNum * sizeof(MaxMeshPolyFace))) return false;
+	const int* corners = (const int*)buffer.data();
+	const MaxMeshPolyFace* faces = (const MaxMeshPolyFace*)flags.data();
+	atomic<bool> valid = true;
+	RestoreLoop(fNum, cNum * sizeof(int), [&](size_t i) {
+		MNFace* face = mesh.F((int)i);
+		face->SetDeg(degrees[i]);
+		for (int j = 0; j < degrees[i]; j++)
+		{
+			int vertex = corners[offsets[i] + j];
+			if (vertex < 0 || (size_t)vertex >= vNum) { valid = false; vertex = 0; }
+			face->vtx[j] = vertex;
+		}
+		face->smGroup = faces[i].smGroup;
+		face->material = faces[i].material;
+	});
+	BUFFER_FREE(buffer); BUFFER_FREE(flags);
+	if (!valid) return false;
+
+	// Build Edges & Vertex Adjacency
+	{
+		ScopedStage stage(opStats, "fillInMesh");
+		mesh.FillInMesh();
+	}
+
+	// Texture Map Channel
+	mesh.SetMapNum(2);
+	mesh.M(0)->SetFlag(MN_DEAD);
+	mesh.M(1)->SetFlag(MN_DEAD);
+	bool decoded =
+		DecodePolyMap(unzipper, meshMeta, degrees, offsets, mesh, streamed) &&
+		DecodePolyNormals(unzipper, meshMeta, degrees, offsets, mesh, streamed);
+	BUFFER_FREE(pdg_buffer);
+	if (!decoded) return false;
+
+	mesh.InvalidateGeomCache();
+	mesh.InvalidateTopoCache();
+	return true;
+}
+bool BuildPolyFromCache(Unzipper& unzipper, const MaxMeshMetaData& meshMeta, MNMesh& mesh, bool precharged = false)
+{
+	ScopedStage stage(opStats, "build");
+
+	// Charged Up Front, An Oversized Package Fails Before Allocating, Unless The Caller Already Holds It
+	ScopedCharge meshCharge(memoryLedger, LedgerMeshes, precharged ? 0 : PolyMeshBytes(meshMeta));
+	if (!IsMemoryGranted(meshCharge, L"decoded mesh")) return false;
+
+	// Native Polygon Channels, No Re-Merging Required
+	if (meshMeta.topology == CACHE_TOPOLOGY_MODE_POLY)
+		return DecodePolyFromCache(unzipper, meshMeta, mesh);
+
+	// Triangle Channels
+	ScopedCharge triCharge(memoryLedger, LedgerMeshes, TriMeshBytes(meshMeta));
+	if (!IsMemoryGranted(triCharge, L"intermediate mesh")) return false;
+	Mesh* newMesh = new Mesh();
+	bool decoded = DecodeMeshFromCache(unzipper, meshMeta, *newMesh);
+
+	if (decoded)
+	{
+		// Finalaizing
+		ScopedStage setFromTri(opStats, "setFromTri");
+		mesh.SetFromTri(*newMesh);
+		mesh.InvalidateGeomCache();
+		mesh.InvalidateTopoCache();
+	}
+
+	// Releasing, Before Merging To Keep Peak Low
+	newMesh->FreeAll();
+	delete newMesh;
+	triCharge.Resize(0);
+
+	// Merge Tris
+	ScopedStage makePolyMesh(opStats, "makePolyMesh");
+	if (decoded) mesh.MakePolyMesh();
+	return decoded;
+}
+bool BuildMeshFromCache(Unzipper& unzipper, const MaxMeshMetaData& meshMeta, Mesh& mesh)
+{
+	ScopedStage stage(opStats, "build");
+
+	// Charged Up Front, An Oversized Package Fails Before Allocating
+	ScopedCharge meshCharge(memoryLedger, LedgerMeshes, TriMeshBytes(meshMeta));
+	if (!IsMemoryGranted(meshCharge, L"decoded mesh")) return false;
+
+	// Triangle Channels Decode Straight Into The Target Mesh
+	if (meshMeta.topology != CACHE_TOPOLOGY_MODE_POLY)
+	{
+		bool decoded = DecodeMeshFromCache(unzipper, meshMeta, mesh);
+		mesh.InvalidateGeomCache();
+		mesh.InvalidateTopologyCache();
+		return decoded;
+	}
+
+	// Native Polygon Channels Need Triangulating
+	ScopedCharge polyCharge(memoryLedger, LedgerMeshes, PolyMeshBytes(meshMeta));
+	if (!IsMemoryGranted(polyCharge, L"intermediate mesh")) return false;
+	MNMesh* polyMesh = new MNMesh();
+	bool decoded = DecodePolyFromCache(unzipper, meshMeta, *polyMesh);
+	if (decoded)
+	{
+		ScopedStage outToTri(opStats, "outToTri");
+		polyMesh->OutToTri(mesh);
+	}
+	polyMesh->ClearAndFree();
+	delete polyMesh;
+	return decoded;
+}
+bool RestoreVerticesInPlace(Unzipper& unzipper, const MaxMeshMetaData& meshMeta, PolyObject* obj)
+{
+	MNMesh& mesh = obj->GetMesh();
+	MNNormalSpec* mesh_ns = mesh.GetSpecifiedNormals();
+
+	// Spatially Chunked Packages Carry No Whole Mesh Channels, They Always Take The Full Rebuild
+	if (IsChunkedPackage(unzipper))
+	{
+		DebugLog(L"Package is spatially chunked, vertices can't be restored in place.");
+		return false;
+	}
+
+	// Topology Validation
+	if (!meshMeta.topologyHash || mesh.numv != meshMeta.vNum || mesh.numf != meshMeta.fNum) return false;
+	if (HashTopology(mesh) != meshMeta.topologyHash) return false;
+
+	// Layout Validation, Face Data & Texture / Normal Corners Must Already Match, Only Native Polygon Packages Carry It
+	if (!meshMeta.layoutHash || meshMeta.topology != CACHE_TOPOLOGY_MODE_POLY || HashLayout(mesh) != meshMeta.layoutHash) return false;
+	bool withNormals = meshMeta.nNum && mesh_ns;
+	BUFFER buffer;
+
+	// Vertices
+	if (!ExtractChannel(unzipper, "max-mesh.vtx", buffer, meshMeta.vNum * sizeof(Point3))) return false;
+
+	// Create Undo/Redo Backup
+	if (theHold.Holding())
+	{
+		RestoreVertsOp* undo = new RestoreVertsOp(obj, withNormals);
+		if (!undo->Accounted()) { delete undo; BUFFER_FREE(buffer); return false; }
+		theHold.Put(undo);
+	}
+
+	const Point3* points = (const Point3*)buffer.data();
+	MULTI_THREAD_LOOP_BEGIN(meshMeta.vNum)
+	mesh.v[i].p = points[i];
+	MULTI_THREAD_LOOP_END
+	BUFFER_FREE(buffer);
+
+	// Normals
+	if (withNormals && ExtractChannel(unzipper, "max-mesh.nrm", buffer, meshMeta.nNum * sizeof(Point3)))
+	{
+		const Point3* normals = (const Point3*)buffer.data();
+		MULTI_THREAD_LOOP_BEGIN(meshMeta.nNum)
+		mesh_ns->Normal((int)i) = normals[i];
+		MULTI_THREAD_LOOP_END
+		BUFFER_FREE(buffer);
+	}
+	else if (mesh_ns)
+	{
+		mesh_ns->SetFlag(MNNORMAL_NORMALS_COMPUTED, false);
+	}
+
+	// Geometry Channel Only
+	mesh.InvalidateGeomCache();
+	obj->NotifyDependents(FOREVER, PART_GEOM, REFMSG_CHANGE);
+	return true;
+}
+// Compact Undo
+bool IsPackagedMesh(MNMesh& mesh)
+{
+	// Channels The Package Doesn't Carry Need a Full Copy
+	for (int m = -NUM_HIDDENMAPS; m < mesh.MNum(); m++)
+	{
+		MNMap* map = mesh.M(m);
+		if (!map || map->GetFlag(MN_DEAD) || !map->numv) continue;
+		if (m != 1 || map->numf != mesh.numf) return false;
+	}
+	for (int d = 0; d < mesh.VDNum(); d++) if (mesh.vDataSupport(d)) return false;
+	for (int d = 0; d < mesh.EDNum(); d++) if (mesh.eDataSupport(d)) return false;
+	return true;
+}
+bool DecodePolyPackage(Unzipper& unzipper, MNMesh& mesh, BYTE channels = RESTORE_CHANNEL_ALL)
+{
+	MaxMeshMetaData meshMeta;
+	bool decoded = ReadMetaFromCache(unzipper, meshMeta) && BuildPolyFromCache(unzipper, SelectChannels(meshMeta, channels), mesh);
+	unzipper.close();
+	return decoded;
+}
+UINT64 EdgeKey(int v1, int v2)
+{
+	return ((UINT64)(UINT32)min(v1, v2) << 32) | (UINT32)max(v1, v2);
+}
+uint64_t CompactUndoBytes(MNMesh& mesh)
+{
+	// Capture Channels & Element Flags From The Live Counts, a Collapsed Copy When Dead Elements Need Dropping
+	MaxMeshMetaData counts;
+	memset(&counts, 0, sizeof(MaxMeshMetaData));
+	bool hasDeadElements = false;
+	counts.vNum = mesh.numv;
+	counts.fNum = mesh.numf;
+	for (int i = 0; i < mesh.numf; i++)
+	{
+		counts.cNum += mesh.f[i].deg;
+		hasDeadElements = hasDeadElements || mesh.f[i].GetFlag(MN_DEAD);
+	}
+	for (int i = 0; i < mesh.numv && !hasDeadElements; i++) hasDeadElements = mesh.v[i].GetFlag(MN_DEAD);
+	MNMap* map = mesh.MNum() > 1 ? mesh.M(1) : nullptr;
+	if (map && !map->GetFlag(MN_DEAD)) counts.tNum = map->numv;
+	MNNormalSpec* mesh_ns = mesh.GetSpecifiedNormals();
+	if (mesh_ns) counts.nNum = mesh_ns->GetNumNormals();
+	return PolyMeshBytes(counts) + (hasDeadElements ? PolyMeshBytes(mesh) : 0) +
+		(uint64_t)(mesh.numv + mesh.numf) * sizeof(DWORD) + (uint64_t)mesh.nume * sizeof(pair<UINT64, DWORD>);
+}
+RestoreMeshOp::RestoreMeshOp(PolyObject* poly, const wchar_t* mxo_package, shared_ptr<const vector<BYTE>> redo_memory, BYTE redo_channels)
+{
+	obj = poly;
+	redo_mxo_package = mxo_package;
+	this->redo_memory = move(redo_memory);
+	this->redo_channels = redo_channels;
+
+	// Charged From The Live Counts Before Anything Is Copied, Refused Records Never Allocate
+	MNMesh& mesh = poly->GetMesh();
+	bool compact = undoMode == UNDO_MODE_COMPACT && IsPackagedMesh(mesh);
+	if (!undo_charge.Resize(compact ? CompactUndoBytes(mesh) : PolyMeshBytes(mesh))) return;
+
+	auto capture = make_shared<MeshCapture>();
+	memset(&capture->meta, 0, sizeof(MaxMeshMetaData));
+	capture->meta.version = MXM_PACKAGE_VERSION;
+	if (!compact || !CapturePolyMesh(poly, GetCOREInterface()->GetTime(), *capture))
+	{
+		if (undo_charge.Resize(PolyMeshBytes(mesh))) this->undo_mnMesh = MNMesh(mesh);
+		return;
+	}
+
+	// Texture Vertices Are Referenced In Place, The Mesh Is About To Change
+	for (auto& channel : capture->channels)
+	{
+		if (strcmp(channel.entry, "max-mesh.tex") != 0) continue;
+		const UVVert* mapVerts = (const UVVert*)channel.data;
+		capture->mapVerts.assign(mapVerts, mapVerts + channel.size / sizeof(UVVert));
+		channel.data = capture->mapVerts.data();
+	}
+	capture->AddChannel("max-mesh.mta", &capture->meta, 1);
+	for (auto& channel : capture->channels) undo_rawSize += channel.size;
+
+	// Every Flag Of Live Elements In Collapsed Order, Edges By Their Vertices As Decoding Renumbers Them
+	vector<int> collapsed(mesh.numv, -1);
+	for (int i = 0; i < mesh.numv; i++)
+	{
+		if (mesh.v[i].GetFlag(MN_DEAD)) continue;
+		collapsed[i] = (int)undo_vertFlags.size();
+		undo_vertFlags.push_back(mesh.v[i].ExportFlags());
+	}
+	for (int i = 0; i < mesh.numf; i++) if (!mesh.f[i].GetFlag(MN_DEAD)) undo_faceFlags.push_back(mesh.f[i].ExportFlags());
+	for (int i = 0; i < mesh.nume; i++)
+	{
+		const MNEdge& edge = mesh.e[i];
+		if (edge.GetFlag(MN_DEAD) || edge.v1 < 0 || edge.v2 < 0 || edge.v1 >= mesh.numv || edge.v2 >= mesh.numv) continue;
+		if (collapsed[edge.v1] >= 0 && collapsed[edge.v2] >= 0) undo_edgeFlags.emplace_back(EdgeKey(collapsed[edge.v1], collapsed[edge.v2]), edge.ExportFlags());
+	}
+	if (!undo_charge.Resize(undo_rawSize + FlagBytes())) return;
+
+	// Compressed Off The Main Thread, Decoded Only If Undo Is Invoked
+	undo_package = async(launch::async, [capture]()
+	{
+		auto package = make_shared<vector<BYTE>>();
+		try { WriteMeshPackage(*capture, *package, Zipper::Faster); }
+		catch (...) { package.reset(); }
+		return package;
+	}).share();
+}
+void RestoreMeshOp::Restore(int isUndo)
+{
+	if (!undo_package.valid())
+	{
+		obj->mm.ClearAndFree();
+		obj->mm = this->undo_mnMesh;
+		obj->NotifyDependents(FOREVER, ALL_CHANNELS, REFMSG_CHANGE);
+		return;
+	}
+
+	// Putting Back Memory The Operation Gave Up, Never Refused By Its Limit
+	auto package = undo_package.get();
+	if (!package) { DebugLog(L"Undo package could not be written, mesh left as it is."); return; }
+	ScopedLimitSuspension suspension(memoryLedger);
+	RegionInStream stream(package->data(), package->size());
+	Unzipper unzipper(stream);
+
+	// Decoded Aside, a Failure Leaves The Current Mesh Whole
+	MNMesh* decoded = new MNMesh();
+	if (!DecodePolyPackage(unzipper, *decoded))
+	{
+		decoded->ClearAndFree();
+		delete decoded;
+		DebugLog(L"Undo package could not be decoded, mesh left as it is.");
+		return;
+	}
+	MNMesh& mesh = obj->GetMesh();
+	mesh.ClearAndFree();
+	mesh = *decoded;
+	decoded->ClearAndFree();
+	delete decoded;
+
+	if ((int)undo_vertFlags.size() == mesh.numv && (int)undo_faceFlags.size() == mesh.numf)
+	{
+		for (int i = 0; i < mesh.numv; i++) mesh.v[i].ImportFlags(undo_vertFlags[i]);
+		for (int i = 0; i < mesh.numf; i++) mesh.f[i].ImportFlags(undo_faceFlags[i]);
+		for (auto& edge : undo_edgeFlags)
+		{
+			int e = mesh.FindEdgeFromVertToVert((int)(edge.first >> 32), (int)(edge.first & 0xFFFFFFFF));
+			if (e >= 0) mesh.e[e].ImportFlags(edge.second);
+		}
+	}
+	obj->NotifyDependents(FOREVER, ALL_CHANNELS, REFMSG_CHANGE);
+}
+void RestoreMeshOp::Redo()
+{
+	// Straight From The Restored Package, Never Through a New Hold
+	PackageReader reader;
+	if (redo_memory)
+	{
+		reader.memory = redo_memory;
+		reader.stream = make_unique<RegionInStream>(reader.memory->data(), reader.memory->size());
+		reader.unzipper = make_unique<Unzipper>(*reader.stream);
+	}
+	else
+	{
+		wstring packagews(redo_mxo_package);
+		if (!OpenPackage(string(packagews.begin(), packagews.end()), reader)) return;
+	}
+
+	if (!DecodePolyPackage(*reader.unzipper, obj->GetMesh(), redo_channels)) { DebugLog(L"Redo package [%s] could not be decoded.", redo_mxo_package.c_str()); return; }
+	obj->NotifyDependents(FOREVER, ALL_CHANNELS, REFMSG_CHANGE);
+}
+int RestoreMeshOp::Size()
+{
+	// Raw Channel Bytes Until The Background Compression Lands
+	if (!undo_package.valid())
+		return (int)min<uint64_t>(INT_MAX, PolyMeshBytes(undo_mnMesh));
+	size_t size = FlagBytes();
+	if (undo_package.wait_for(chrono::seconds(0)) != future_status::ready) size += undo_rawSize;
+	else if (undo_package.get()) size += undo_package.get()->size();
+	undo_charge.Resize(size);
+	return (int)min<size_t>(INT_MAX, size);
+}
+
+bool GenerateNodeFromCache(const wchar_t* mxm_package, int lod = 0, BYTE channels = RESTORE_CHANNEL_ALL)
+{
+	profiler.Reset(); profiler.Start();
+	DebugLog(L"Restoring object from cache file [%s]...", mxm_package);
+
+	if (restoreMode == RESTORE_CACHE_MODE_SINGLE_THREAD)
+		DebugLog(L"Config `Restore Mode` = RESTORE_CACHE_MODE_SINGLE_THREAD");
+	if (restoreMode == RESTORE_CACHE_MODE_MULTI_THREAD)
+		DebugLog(L"Config `Restore Mode` = RESTORE_CACHE_MODE_MULTI_THREAD");
+	if (restoreMode == RESTORE_CACHE_MODE_AUTO)
+		DebugLog(L"Config `Restore Mode` = RESTORE_CACHE_MODE_AUTO (parallel from %llu KB)",
+			(unsigned long long)(copyCalibration.parallelThreshold >> 10));
+	if (restoreTarget == RESTORE_TARGET_EDITABLE_POLY)
+		DebugLog(L"Config `Restore Target` = RESTORE_TARGET_EDITABLE_POLY");
+	if (restoreTarget == RESTORE_TARGET_EDITABLE_MESH)
+		DebugLog(L"Config `Restore Target` = RESTORE_TARGET_EDITABLE_MESH");
+
+	// Convert Package Name
+	wstring mxm_package_ws(mxm_package);
+	string mxm_package_str(mxm_package_ws.begin(), mxm_package_ws.end());
+	ScopedOperation operation(opStats, "restore", mxm_package_str.c_str());
+
+	// Create Object
+	TimeValue t = GetCOREInterface()->GetTime();
+	Object* obj = nullptr;
+	bool restored = false;
+
+	// Import Mesh
+	PackageReader reader;
+	if (!OpenPackage(mxm_package_str, lod, reader))
+	{
+		DebugLog(L"Restoring cache [%s] failed, package not found.", mxm_package);
+		return false;
+	}
+	Unzipper& unzipper = *reader.unzipper;
+	MaxMeshMetaData meshMeta;
+	if (ReadMetaFromCache(unzipper, meshMeta))
+	{
+		meshMeta = SelectChannels(meshMeta, channels);
+		if (restoreTarget == RESTORE_TARGET_EDITABLE_MESH)
+		{
+			TriObject* tobj = (TriObject*)CreateInstance(GEOMOBJECT_CLASS_ID, triobjectCID);
+			restored = BuildMeshFromCache(unzipper, meshMeta, tobj->GetMesh());
+			obj = tobj;
+		}
+		else
+		{
+			PolyObject* pobj = (PolyObject*)CreateInstance(GEOMOBJECT_CLASS_ID, EPOLYOBJ_CLASS_ID);
+			restored = BuildPolyFromCache(unzipper, meshMeta, pobj->GetMesh());
+			obj = pobj;
+		}
+	}
+	unzipper.close();
+	if (!restored)
+	{
+		if (obj) obj->MaybeAutoDelete();
+		DebugLog(L"Restoring cache [%s] failed.", mxm_package);
+		return false;
+	}
+
+	// Set Configs
+	INode* newNode = maxInterface->CreateObjectNode(obj);
+	newNode->SetName(StringGetWideChar(meshMeta.name));
+	newNode->SetNodeTM(t, meshMeta.tm);
+	newNode->SetWireColor(meshMeta.col);
+
+	// Update 
+	{
+		ScopedStage stage(opStats, "redraw");
+		GetCOREInterface()->RedrawViews(t);
+	}
+	obj->NotifyDependents(FOREVER, ALL_CHANNELS, REFMSG_CHANGE);
+
+	TouchCatalogPackage(mxm_package);
+	DebugLog(L"Cache [%s] successfully restored to %s in %f ms",
+		mxm_package,
+		newNode->GetName(),
+		profiler.ElapsedMilliseconds());
+
+	operation.Succeed();
+	return true;
+}
+bool GenerateNewPolyFromCache(const wchar_t* mxm_package, INode* node, int lod, BYTE channels)
+{
+	theHold.Begin();
+	profiler.Reset(); profiler.Start();
+	DebugLog(L"Restoring mesh from cache file [%s]...", mxm_package);
+
+	if (restoreMode == RESTORE_CACHE_MODE_SINGLE_THREAD)
+		DebugLog(L"Config `Restore Mode` = RESTORE_CACHE_MODE_SINGLE_THREAD");
+	if (restoreMode == RESTORE_CACHE_MODE_MULTI_THREAD)
+		DebugLog(L"Config `Restore Mode` = RESTORE_CACHE_MODE_MULTI_THREAD");
+	if (restoreMode == RESTORE_CACHE_MODE_AUTO)
+		DebugLog(L"Config `Restore Mode` = RESTORE_CACHE_MODE_AUTO (parallel from %llu KB)",
+			(unsigned long long)(copyCalibration.parallelThreshold >> 10));
+
+	// Convert Package Name
+	wstring mxm_package_ws(mxm_package);
+	string mxm_package_str(mxm_package_ws.begin(), mxm_package_ws.end());
+	ScopedOperation operation(opStats, "restore", mxm_package_str.c_str());
+
+	// Get Poly Object
+	PolyObject* obj = (PolyObject*)node->GetObjectRef();
+
+	// Geometry Validation
+	if (obj->FindBaseObject()->SuperClassID() != GEOMOBJECT_CLASS_ID) { theHold.Cancel(); return false; }
+
+	// Editable Poly Validation
+	if (obj->FindBaseObject()->ClassID() != EPOLYOBJ_CLASS_ID) { theHold.Cancel(); return false; }
+
+	// Read Meta Data
+	PackageReader reader;
+	if (!OpenPackage(mxm_package_str, lod, reader))
+	{
+		theHold.Cancel();
+		DebugLog(L"Restoring cache [%s] failed, package not found.", mxm_package);
+		return false;
+	}
+	Unzipper& unzipper = *reader.unzipper;
+	MaxMeshMetaData meshMeta;
+	if (!ReadMetaFromCache(unzipper, meshMeta))
+	{
+		unzipper.close(); theHold.Cancel();
+		DebugLog(L"Restoring cache [%s] failed.", mxm_package);
+		return false;
+	}
+	meshMeta = SelectChannels(meshMeta, channels);
+
+	// Same Topology, Overwrite Vertices In Place
+	if (RestoreVerticesInPlace(unzipper, meshMeta, obj))
+	{
+		unzipper.close();
+		{
+			ScopedStage stage(opStats, "redraw");
+			GetCOREInterface()->RedrawViews(GetCOREInterface()->GetTime());
+		}
+		DebugLog(L"Cache [%s] vertices restored in place to %s in %f ms", mxm_package, node->GetName(), profiler.ElapsedMilliseconds());
+		theHold.Accept(L"MXMesh :: RestoreMesh");
+		operation.Succeed();
+		return true;
+	}
+
+	// Create Undo/Redo Backup
+	RestoreMeshOp* undo = new RestoreMeshOp(obj, mxm_package, reader.memory, channels);
+	if (!undo->Accounted())
+	{
+		delete undo;
+		unzipper.close(); theHold.Cancel();
+		DebugLog(L"Restoring cache [%s] failed, undo record exceeds the operation memory limit.", mxm_package);
+		return false;
+	}
+	theHold.Put(undo);
+
+	// Get Mesh
+	MNMesh& mesh = obj->GetMesh();
+
+	// Import Mesh, Undo Backup Puts The Mesh Back On Failure
+	bool restored = BuildPolyFromCache(unzipper, meshMeta, mesh);
+	unzipper.close();
+	if (!restored)
+	{
+		theHold.Cancel();
+		obj->NotifyDependents(FOREVER, ALL_CHANNELS, REFMSG_CHANGE);
+		DebugLog(L"Restoring cache [%s] failed.", mxm_package);
+		return false;
+	}
+
+	// Update 
+	{
+		ScopedStage stage(opStats, "redraw");
+		GetCOREInterface()->RedrawViews(GetCOREInterface()->GetTime());
+	}
+	obj->NotifyDependents(FOREVER, ALL_CHANNELS, REFMSG_CHANGE);
+
+	TouchCatalogPackage(mxm_package);
+	DebugLog(L"Cache [%s] successfully restored to %s in %f ms", mxm_package, node->GetName(), profiler.ElapsedMilliseconds());
+
+	theHold.Accept(L"MXMesh :: RestoreMesh");
+	operation.Succeed();
+	return true;
+}
+bool GenerateNewPolyFromCache(const wchar_t* mxm_package, const vector<INode*>& nodes, int lod = 0, BYTE channels = RESTORE_CHANNEL_ALL)
+{
+	// Single Target Keeps The In-Place Vertex Path
+	if (nodes.size() == 1) return GenerateNewPolyFromCache(mxm_package, nodes[0], lod, channels);
+
+	profiler.Reset(); profiler.Start();
+	DebugLog(L"Restoring mesh from cache file [%s] to %d nodes...", mxm_package, (int)nodes.size());
+
+	// Convert Package Name
+	wstring mxm_package_ws(mxm_package);
+	string mxm_package_str(mxm_package_ws.begin(), mxm_package_ws.end());
+	ScopedOperation operation(opStats, "restore", mxm_package_str.c_str());
+
+	// Editable Poly Targets Only, Base Objects Below Any Modifiers
+	vector<pair<INode*, PolyObject*>> targets;
+	for (INode* node : nodes)
+	{
+		if (!node) continue;
+		Object* base = node->GetObjectRef()->FindBaseObject();
+		if (base->SuperClassID() != GEOMOBJECT_CLASS_ID || base->ClassID() != EPOLYOBJ_CLASS_ID)
+		{
+			DebugLog(L"Skipping [%s], not an editable poly.", node->GetName());
+			continue;
+		}
+		targets.push_back(make_pair(node, (PolyObject*)base));
+	}
+	if (targets.empty()) return false;
+
+	// Decode Once
+	PackageReader reader;
+	if (!OpenPackage(mxm_package_str, lod, reader))
+	{
+		DebugLog(L"Restoring cache [%s] failed, package not found.", mxm_package);
+		return false;
+	}
+	Unzipper& unzipper = *reader.unzipper;
+	MaxMeshMetaData meshMeta;
+	bool restored = ReadMetaFromCache(unzipper, meshMeta);
+
+	// Decoded Copy Outlives The Build, Charged Before Decoding & Held Until Every Target Has It
+	MaxMeshMetaData selectedMeta = SelectChannels(meshMeta, channels);
+	ScopedCharge decodedCharge(memoryLedger, LedgerMeshes, restored ? PolyMeshBytes(selectedMeta) : 0);
+	restored = restored && IsMemoryGranted(decodedCharge, L"decoded mesh");
+	MNMesh* decoded = new MNMesh();
+	restored = restored && BuildPolyFromCache(unzipper, selectedMeta, *decoded, true);
+	unzipper.close();
+	if (!restored)
+	{
+		decoded->ClearAndFree();
+		delete decoded;
+		DebugLog(L"Restoring cache [%s] failed.", mxm_package);
+		return false;
+	}
+
+	// Copy To Every Target Under One Undo Record
+	theHold.Begin();
+	bool accounted = true;
+	for (auto& target : targets)
+	{
+		PolyObject* obj = target.second;
+		RestoreMeshOp* undo = new RestoreMeshOp(obj, mxm_package, reader.memory, channels);
+		if (!undo->Accounted()) { delete undo; accounted = false; break; }
+		theHold.Put(undo);
+		obj->GetMesh() = *decoded;
+		obj->NotifyDependents(FOREVER, ALL_CHANNELS, REFMSG_CHANGE);
+	}
+
+	// Targets Already Copied Are Put Back By Cancelling The Hold
+	if (accounted) theHold.Accept(L"MXMesh :: RestoreMesh");
+	else theHold.Cancel();
+
+	decoded->ClearAndFree();
+	delete decoded;
+	if (!accounted)
+	{
+		DebugLog(L"Restoring cache [%s] failed, undo records exceed the operation memory limit.", mxm_package);
+		return false;
+	}
+
+	// Update
+	{
+		ScopedStage stage(opStats, "redraw");
+		GetCOREInterface()->RedrawViews(GetCOREInterface()->GetTime());
+	}
+
+	TouchCatalogPackage(mxm_package);
+	DebugLog(L"Cache [%s] successfully restored to %d nodes in %f ms", mxm_package, (int)targets.size(), profiler.ElapsedMilliseconds());
+	operation.Succeed();
+	return true;
+}
+BYTE PresentChannels(MNMesh& mesh)
+{
+	BYTE channels = RESTORE_CHANNEL_GEOMETRY;
+	if (mesh.MNum() > 1 && !mesh.M(1)->GetFlag(MN_DEAD)) channels |= RESTORE_CHANNEL_UVS;
+	if (mesh.GetSpecifiedNormals()) channels |= RESTORE_CHANNEL_NORMALS;
+	return channels;
+}
+bool AttachChannelsFromCache(const wchar_t* mxm_package, INode* node, BYTE channels)
+{
+	if (!node) { return false; }
+	profiler.Reset(); profiler.Start();
+	DebugLog(L"Attaching channels from cache file [%s] to %s...", mxm_package, node->GetName());
+
+	// Convert Package Name
+	wstring mxm_package_ws(mxm_package);
+	string mxm_package_str(mxm_package_ws.begin(), mxm_package_ws.end());
+	ScopedOperation operation(opStats, "attachChannels", mxm_package_str.c_str());
+
+	// Editable Poly Validation
+	Object* base = node->GetObjectRef()->FindBaseObject();
+	if (base->SuperClassID() != GEOMOBJECT_CLASS_ID || base->ClassID() != EPOLYOBJ_CLASS_ID) return false;
+	PolyObject* obj = (PolyObject*)base;
+	MNMesh& mesh = obj->GetMesh();
+
+	PackageReader reader;
+	if (!OpenPackage(mxm_package_str, reader))
+	{
+		DebugLog(L"Attaching channels of [%s] failed, package not found.", mxm_package);
+		return false;
+	}
+	Unzipper& unzipper = *reader.unzipper;
+
+	// Corners Are Read From The Whole Mesh Channels, Spatially Chunked Packages Only Carry Cells
+	if (IsChunkedPackage(unzipper))
+	{
+		unzipper.close();
+		DebugLog(L"Attaching channels of [%s] failed, spatially chunked packages can only be restored whole or by region.", mxm_package);
+		return false;
+	}
+
+	// Corners Must Line Up, Only Polygon Packages Of The Same Topology Qualify
+	MaxMeshMetaData meshMeta;
+	BUFFER pdg_buffer;
+	bool matching = ReadMetaFromCache(unzipper, meshMeta) && meshMeta.topology == CACHE_TOPOLOGY_MODE_POLY &&
+		meshMeta.vNum == mesh.numv && meshMeta.fNum == mesh.numf &&
+		(!meshMeta.topologyHash || HashTopology(mesh) == meshMeta.topologyHash) &&
+		ExtractChannel(unzipper, "max-mesh.pdg", pdg_buffer, meshMeta.fNum * sizeof(int));
+	const int* degrees = (const int*)pdg_buffer.data();
+	vector<size_t> offsets(matching ? meshMeta.fNum + 1 : 1, 0);
+	for (int i = 0; matching && i < meshMeta.fNum; i++)
+	{
+		matching = degrees[i] == mesh.f[i].deg;
+		offsets[i + 1] = offsets[i] + degrees[i];
+	}
+	matching = matching && offsets.back() == (size_t)meshMeta.cNum;
+	if (!matching)
+	{
+		BUFFER_FREE(pdg_buffer); unzipper.close();
+		DebugLog(L"Attaching channels of [%s] failed, %s does not share the package topology.", mxm_package, node->GetName());
+		return false;
+	}
+
+	// Geometry Stays, Only The Selected Channels Are Inflated
+	MaxMeshMetaData selected = SelectChannels(meshMeta, channels);
+	ScopedCharge channelCharge(memoryLedger, LedgerMeshes, PolyMeshBytes(selected) - PolyMeshBytes(SelectChannels(meshMeta, RESTORE_CHANNEL_GEOMETRY)));
+	if (!IsMemoryGranted(channelCharge, L"attached channels")) { BUFFER_FREE(pdg_buffer); unzipper.close(); return false; }
+
+	// Redo Rebuilds From The Package With Every Channel The Mesh Ends Up With
+	theHold.Begin();
+	RestoreMeshOp* undo = new RestoreMeshOp(obj, mxm_package, reader.memory, PresentChannels(mesh) | channels);
+	if (!undo->Accounted())
+	{
+		delete undo;
+		BUFFER_FREE(pdg_buffer); unzipper.close(); theHold.Cancel();
+		DebugLog(L"Attaching channels of [%s] failed, undo record exceeds the operation memory limit.", mxm_package);
+		return false;
+	}
+	theHold.Put(undo);
+
+	bool attached = false;
+	{
+		ScopedStage stage(opStats, "attach");
+		bool streamed = IsStreamedRestore(unzipper, selected);
+		int maps = mesh.MNum();
+		if (selected.tNum && maps < 2)
+		{
+			mesh.SetMapNum(2);
+			if (maps < 1) mesh.M(0)->SetFlag(MN_DEAD);
+		}
+		attached =
+			DecodePolyMap(unzipper, selected, degrees, offsets, mesh, streamed) &&
+			DecodePolyNormals(unzipper, selected, degrees, offsets, mesh, streamed);
+	}
+	BUFFER_FREE(pdg_buffer);
+	unzipper.close();
+	if (!attached)
+	{
+		theHold.Cancel();
+		obj->NotifyDependents(FOREVER, ALL_CHANNELS, REFMSG_CHANGE);
+		DebugLog(L"Attaching channels of [%s] failed.", mxm_package);
+		return false;
+	}
+	mesh.InvalidateGeomCache();
+	mesh.InvalidateTopoCache();
+
+	// Update
+	obj->NotifyDependents(FOREVER, ALL_CHANNELS, REFMSG_CHANGE);
+	{
+		ScopedStage stage(opStats, "redraw");
+		GetCOREInterface()->RedrawViews(GetCOREInterface()->GetTime());
+	}
+
+	TouchCatalogPackage(mxm_package);
+	DebugLog(L"Channels of [%s] attached to %s in %f ms", mxm_package, node->GetName(), profiler.ElapsedMilliseconds());
+	theHold.Accept(L"MXMesh :: AttachChannels");
+	operation.Succeed();
+	return true;
+}
+vector<INode*> NodesFromValue(Value* value)
+{
+	// A Single Node Or An Array Of Nodes
+	vector<INode*> nodes;
+	if (is_array(value))
+	{
+		Array* items = (Array*)value;
+		nodes.reserve(items->size);
+		for (int i = 0; i < items->size; i++) nodes.push_back(items->data[i]->to_node());
+	}
+	else nodes.push_back(value->to_node());
+	return nodes;
+}
+bool CopyMeshToClipboard(INode* node)
+{
+	if (!node) { return false; }
+	ScopedOperation operation(opStats, "copy", StatsTarget(node).c_str());
+	DebugLog(L"Copying object data [%s] to clipboard...", node->GetName());
+
+	profiler.Reset(); profiler.Start();
+
+	TimeValue t = GetCOREInterface()->GetTime();
+	MeshCapture capture;
+
+	if (CaptureMesh(node, t, capture))
+	{
+		// Stored Uncompressed, Kept For This Session And Shared With Other Instances
+		auto package = make_shared<Package>();
+		WriteMeshPackage(capture, *package, Zipper::Store);
+		RecordPackageStats(*package);
+		clipboardPackage = package;
+		if (!sharedClipboard.Publish(package->data(), package->size(), clipboardGeneration))
+			DebugLog(L"Shared clipboard unavailable, copy is visible to this session only.");
+
+		DebugLog(L"Object [%s] mesh data successfully copied in %f ms (%llu KB)", node->GetName(),
+			profiler.ElapsedMilliseconds(), (unsigned long long)(package->size() >> 10));
+		operation.Succeed();
+		return true;
+	}
+
+	DebugLog(L"Copying object [%s] mesh data failed.", node->GetName());
+	return false;
+}
+bool SyncClipboard()
+{
+	// Another Instance Copied Since, Pull Its Package Once
+	uint64_t generation = sharedClipboard.Generation();
+	if (generation && generation != clipboardGeneration)
+	{
+		auto package = make_shared<Package>();
+		if (!sharedClipboard.Fetch(*package, generation))
+		{
+			// Newer Than Ours, Pasting Our Own Older Copy Instead Would Be Wrong
+			clipboardPackage = nullptr;
+			clipboardGeneration = generation;
+			DebugLog(L"Shared clipboard unavailable, the session that copied last has exited.");
+			return false;
+		}
+		clipboardPackage = package;
+		clipboardGeneration = generation;
+		DebugLog(L"Clipboard package fetched from another session (%llu KB).", (unsigned long long)(package->size() >> 10));
+	}
+	return clipboardPackage != nullptr;
+}
+bool PasteMeshFromClipboard(const vector<INode*>& nodes)
+{
+	if (!SyncClipboard()) { DebugLog(L"Clipboard is empty."); return false; }
+	return GenerateNewPolyFromCache(L"" CLIPBOARD_PACKAGE_NAME, nodes);
+}
+
+// Checkpoint Catalog
+path CatalogFilePath()
+{
+	return path(cachePath) / CATALOG_FILE_NAME;
+}
+bool IsCatalogPackage(const path& package)
+{
+	string ext = package.extension().string(); String2Lower(ext);
+	string stem = package.stem().string(); String2Lower(stem);
+	return ext == ".mxo" && stem != "mxmeshstorage";
+}
+file_time_type CatalogFolderStamp()
+{
+	error_code error;
+	return filesystem::last_write_time(path(cachePath), error);
+}
+void RecordBounds(const Point3* points, size_t count, CatalogRecord& record)
+{
+	if (count == 0) return;
+	Point3 pmin = points[0], pmax = points[0];
+	for (size_t i = 1; i < count; i++)
+	{
+		pmin.x = min(pmin.x, points[i].x); pmin.y = min(pmin.y, points[i].y); pmin.z = min(pmin.z, points[i].z);
+		pmax.x = max(pmax.x, points[i].x); pmax.y = max(pmax.y, points[i].y); pmax.z = max(pmax.z, points[i].z);
+	}
+	memcpy(record.bboxMin, &pmin, sizeof(record.bboxMin));
+	memcpy(record.bboxMax, &pmax, sizeof(record.bboxMax));
+}
+void RecordMeta(const MaxMeshMetaData& meshMeta, const path& package, CatalogRecord& record)
+{
+	string file = package.filename().string(); String2Lower(file);
+	strncpy_s(record.file, sizeof record.file, file.c_str(), _TRUNCATE);
+	strncpy_s(record.node, sizeof record.node, meshMeta.name, _TRUNCATE);
+	record.vNum = meshMeta.vNum;
+	record.fNum = meshMeta.fNum;
+	record.fingerprint = meshMeta.topologyHash;
+
+	error_code error;
+	record.packageSize = filesystem::file_size(package, error);
+	if (error) record.packageSize = 0;
+}
+bool RecordFromPackage(const path& package, CatalogRecord& record)
+{
+	memset(&record, 0, sizeof(CatalogRecord));
+
+	// Unknown Package, One Time Inflate Of Header & Vertices
+	try
+	{
+		Unzipper unzipper(package.string());
+		MaxMeshMetaData meshMeta;
+		bool valid = ReadMetaFromCache(unzipper, meshMeta);
+		if (valid)
+		{
+			for (auto& entry : unzipper.entries()) record.rawSize += entry.uncompressedSize;
+			BUFFER buffer;
+			if (meshMeta.version >= 4)
+				RecordBounds(&meshMeta.bounds.pmin, 2, record);
+			else if (ExtractChannel(unzipper, "max-mesh.vtx", buffer, meshMeta.vNum * sizeof(Point3)))
+				RecordBounds((const Point3*)buffer.data(), meshMeta.vNum, record);
+			BUFFER_FREE(buffer);
+			RecordMeta(meshMeta, package, record);
+		}
+		unzipper.close();
+		if (!valid) return false;
+	}
+	catch (...) { return false; }
+
+	error_code error;
+	auto written = filesystem::last_write_time(package, error);
+	if (!error)
+		record.timestamp = chrono::duration_cast<chrono::seconds>(written - file_time_type::clock::now()).count() + time(nullptr);
+	return true;
+}
+size_t SyncCatalog(bool rebuild)
+{
+	// Same Folder, Untouched Since Our Last Write, Nothing To Do
+	path catalogFile = CatalogFilePath();
+	file_time_type stamp = CatalogFolderStamp();
+	bool loaded = catalog.File() == catalogFile;
+	if (!rebuild && loaded && stamp == catalogFolderStamp) return 0;
+
+	if (!loaded) { catalog.Load(catalogFile); cacheSweepCursor = 0; }
+
+	// Reconcile With Folder Listing, Archives Are Only Opened For Unknown Packages
+	size_t changes = 0;
+	vector<string> present;
+	error_code error;
+	for (auto& entry : directory_iterator(path(cachePath), error))
+	{
+		if (!entry.is_regular_file() || !IsCatalogPackage(entry.path())) continue;
+		string file = entry.path().filename().string(); String2Lower(file);
+		present.push_back(file);
+		const CatalogRecord* known = catalog.Find(file.c_str());
+		if (known && !rebuild) continue;
+
+		// Rebuilds Keep Pins & Usage History
+		CatalogRecord record;
+		if (!RecordFromPackage(entry.path(), record)) continue;
+		if (known) { record.flags = known->flags; record.lastAccess = known->lastAccess; }
+		catalog.Upsert(record); changes++;
+	}
+	sort(present.begin(), present.end());
+
+	vector<string> missing;
+	for (auto& record : catalog.Records())
+		if (!binary_search(present.begin(), present.end(), string(record.file)) &&
+			!migrationQueue.IsPending(path(cachePath) / record.file)) missing.push_back(record.file);
+	for (auto& file : missing) { catalog.Remove(file.c_str()); changes++; }
+
+	if (changes || rebuild || catalogDirty) { catalog.Save(); catalogDirty = false; }
+	catalogFolderStamp = CatalogFolderStamp();
+
+	DebugLog(L"Checkpoint catalog synchronized, %d change(s), %d package(s).", (int)changes, (int)catalog.Records().size());
+	return changes;
+}
+bool IsOverQuota()
+{
+	const CatalogQuota& quota = catalog.Quota();
+	return (quota.bytes && catalog.TotalSize() > quota.bytes) ||
+		(quota.count && catalog.Records().size() > quota.count);
+}
+bool SweepCacheStep(size_t validateBudget, size_t evictBudget, size_t& evicted)
+{
+	SyncCatalog(false);
+	bool changed = false;
+	size_t removed = 0;
+	error_code error;
+
+	// Validate a Slice Of Records, Round Robin Across Ticks
+	for (size_t n = 0; n < validateBudget && !catalog.Records().empty(); n++)
+	{
+		if (cacheSweepCursor >= catalog.Records().size()) cacheSweepCursor = 0;
+		CatalogRecord& record = *catalog.Find(catalog.Records()[cacheSweepCursor].file);
+		path package = path(cachePath) / record.file;
+		if (migrationQueue.IsPending(package)) { cacheSweepCursor++; continue; }
+		uintmax_t size = filesystem::file_size(package, error);
+		if (error) { catalog.Remove(record.file); changed = true; removed++; continue; }
+		if (size != record.packageSize) { record.packageSize = size; changed = true; }
+		cacheSweepCursor++;
+	}
+
+	// Evict Least Recently Used, Pinned Packages Are Skipped
+	if (IsOverQuota())
+	{
+		for (auto& file : catalog.EvictionOrder())
+		{
+			if (!evictBudget-- || !IsOverQuota()) break;
+			RemovePackageTiers(path(cachePath) / file);
+			filesystem::remove(path(cachePath) / file, error);
+			if (error) continue;
+			catalog.Remove(file.c_str());
+			changed = true; evicted++; removed++;
+			DebugLog(L"Cache quota exceeded, evicted [%S].", file.c_str());
+		}
+	}
+
+	if (changed || catalogDirty)
+	{
+		catalog.Save(); catalogDirty = false;
+		catalogFolderStamp = CatalogFolderStamp();
+	}
+
+	// Another Pass Only Helps While Over Quota & This One Removed Something
+	return IsOverQuota() && removed;
+}
+void CALLBACK CacheSweepTimerProc(HWND, UINT, UINT_PTR, DWORD)
+{
+	// Stops Once Only Pinned Packages Or Failing Removals Are Left, The Next Cache Write Re-Arms It
+	size_t evicted = 0;
+	if (SweepCacheStep(CACHE_SWEEP_VALIDATE_BATCH, CACHE_SWEEP_EVICT_BATCH, evicted)) return;
+	KillTimer(NULL, cacheSweepTimer);
+	cacheSweepTimer = 0;
+}
+void ScheduleCacheSweep()
+{
+	if (!cacheSweepTimer) cacheSweepTimer = SetTimer(NULL, 0, CACHE_SWEEP_INTERVAL, CacheSweepTimerProc);
+}
+void CatalogPackage(const MeshCapture& capture, const char* packagePath, const path& writtenPath)
+{
+	ScopedStage stage(opStats, "catalog");
+	SyncCatalog(false);
+
+	// Staged Packages Keep Their Archive Name, Sized From The Written Copy
+	CatalogRecord record;
+	memset(&record, 0, sizeof(CatalogRecord));
+	RecordMeta(capture.meta, writtenPath, record);
+	record.timestamp = record.lastAccess = time(nullptr);
+	for (auto& channel : capture.channels)
+		if (!IsChunkEntry(channel.entry)) record.rawSize += channel.size;
+	for (auto& chunk : capture.chunkIndex) record.rawSize += chunk.rawSize;
+	RecordBounds(&capture.meta.bounds.pmin, 2, record);
+
+	// Overwritten Packages Stay Pinned
+	const CatalogRecord* known = catalog.Find(record.file);
+	if (known) record.flags = known->flags;
+
+	catalog.Upsert(record);
+	catalog.Save(); catalogDirty = false;
+	catalogFolderStamp = CatalogFolderStamp();
+	if (IsOverQuota()) ScheduleCacheSweep();
+}
+void TouchCatalogPackage(const wchar_t* packagePath)
+{
+	// Only Packages Of The Current Cache Folder Are Tracked
+	wstring packagews(packagePath);
+	path package(string(packagews.begin(), packagews.end()));
+	error_code error;
+	if (!filesystem::equivalent(package.parent_path(), path(cachePath), error)) return;
+
+	SyncCatalog(false);
+	string file = package.filename().string(); String2Lower(file);
+	CatalogRecord* record = catalog.Find(file.c_str());
+	if (!record) return;
+
+	// Saved Lazily By The Sweep
+	record->lastAccess = time(nullptr);
+	catalogDirty = true;
+	ScheduleCacheSweep();
+}
+bool IsPinnedPackage(const path& package)
+{
+	error_code error;
+	if (!filesystem::equivalent(package.parent_path(), path(cachePath), error)) return false;
+	string file = package.filename().string(); String2Lower(file);
+	const CatalogRecord* record = catalog.Find(file.c_str());
+	return record && (record->flags & RecordPinned);
+}
+string CatalogFileName(const wchar_t* name)
+{
+	wstring namews(name);
+	string file(namews.begin(), namews.end()); String2Lower(file);
+	if (path(file).extension() != ".mxo") file += ".mxo";
+	return file;
+}
+bool RemoveCatalogPackage(const char* file)
+{
+	SyncCatalog(false);
+
+	error_code error;
+	RemovePackageTiers(path(cachePath) / file);
+	filesystem::remove(path(cachePath) / file, error);
+	if (error) return false;
+
+	if (catalog.Remove(file)) catalog.Save();
+	catalogFolderStamp = CatalogFolderStamp();
+	return true;
+}
+
+// Memory Checkpoints
+string MemoryPackageName(uint64_t id)
+{
+	return MEMORY_PACKAGE_PREFIX + to_string(id);
+}
+bool CheckpointToMemory(INode* node)
+{
+	if (!node) { return false; }
+	ScopedOperation operation(opStats, "memoryCheckpoint", StatsTarget(node).c_str());
+	DebugLog(L"Checkpointing object [%s] to memory...", node->GetName());
+	profiler.Reset(); profiler.Start();
+
+	TimeValue t = GetCOREInterface()->GetTime();
+	MeshCapture capture;
+	if (!CaptureMesh(node, t, capture))
+	{
+		DebugLog(L"Checkpointing object [%s] to memory failed.", node->GetName());
+		return false;
+	}
+
+	// Stored Entries Inflate At Copy Speed, Faster Trades Some Of That For Size
+	auto package = make_shared<Package>();
+	WriteMeshPackage(capture, *package, memoryCheckpointMode == MEMORY_CHECKPOINT_RAW ? Zipper::Store : Zipper::Faster);
+	RecordPackageStats(*package);
+
+	Snapshot snapshot = {};
+	snapshot.owner = node->GetHandle();
+	snapshot.timestamp = time(nullptr);
+	for (auto& channel : capture.channels) snapshot.rawSize += channel.size;
+	snapshot.package = package;
+	uint64_t id = memoryCheckpoints.Push(snapshot);
+	if (!id)
+	{
+		DebugLog(L"Object [%s] snapshot of %llu KB does not fit the memory checkpoint budget.", node->GetName(), (unsigned long long)(package->size() >> 10));
+		return false;
+	}
+
+	DebugLog(L"Object [%s] checkpointed to memory as [%S] in %f ms (%llu KB)", node->GetName(),
+		MemoryPackageName(id).c_str(), profiler.ElapsedMilliseconds(), (unsigned long long)(package->size() >> 10));
+	operation.Succeed();
+	return true;
+}
+bool PromoteMemoryCheckpoint(uint64_t id, string& archivePath)
+{
+	Snapshot snapshot;
+	if (!memoryCheckpoints.Find(id, snapshot)) return false;
+	profiler.Reset(); profiler.Start();
+
+	// Node Name From The Snapshot Header, The Node May Be Gone By Now
+	RegionInStream stream(snapshot.package->data(), snapshot.package->size());
+	Unzipper unzipper(stream);
+	MaxMeshMetaData meshMeta;
+	if (!ReadMetaFromCache(unzipper, meshMeta)) { unzipper.close(); return false; }
+
+	// Recompress Every Channel With The Disk Compression Mode
+	auto package = make_shared<Package>();
+	bool complete = true;
+	{
+		Zipper zipper(*package);
+		for (auto& entry : unzipper.entries())
+		{
+			BUFFER buffer;
+			complete = complete && AcquireStaging(buffer, (size_t)entry.uncompressedSize) && unzipper.extractEntryToMemory(entry.name, buffer);
+			RegionInStream channel(buffer.data(), buffer.size());
+			if (complete) zipper.add(channel, entry.name, compressionMode);
+			BUFFER_FREE(buffer);
+		}
+		zipper.close();
+	}
+	unzipper.close();
+	if (!complete) return false;
+
+	char outputNameBuffer[MAX_PATH];
+	sprintf_s(outputNameBuffer, sizeof outputNameBuffer, "%s\\%s-%s.mxo", cachePath.c_str(), meshMeta.name, gtfrmtt());
+	path written = StorePackageBytes(package, _strlwr(outputNameBuffer));
+	if (written.empty()) return false;
+
+	// Catalog From The Written Copy
+	SyncCatalog(false);
+	CatalogRecord record;
+	if (RecordFromPackage(written, record))
+	{
+		record.lastAccess = record.timestamp;
+		catalog.Upsert(record);
+		catalog.Save(); catalogDirty = false;
+		catalogFolderStamp = CatalogFolderStamp();
+		if (IsOverQuota()) ScheduleCacheSweep();
+	}
+
+	archivePath = outputNameBuffer;
+	DebugLog(L"Memory checkpoint [%S] promoted to %S in %f ms", MemoryPackageName(id).c_str(), outputNameBuffer, profiler.ElapsedMilliseconds());
+	return true;
+}
+
+// Animated Caches
+const MeshChannelView* FindChannel(const MeshCapture& capture, const char* entry)
+{
+	for (auto& channel : capture.channels) if (strcmp(channel.entry, entry) == 0) return &channel;
+	return nullptr;
+}
+bool IsSameTopology(const MaxMeshMetaData& a, const MaxMeshMetaData& b)
+{
+	return a.topology == b.topology && a.vNum == b.vNum && a.fNum == b.fNum && a.cNum == b.cNum && a.topologyHash == b.topologyHash;
+}
+const wchar_t* CodecName(uint32_t codec)
+{
+	switch (codec)
+	{
+	case CodecDelta: return L"delta";
+	case CodecBasis: return L"basis";
+	default: return L"raw";
+	}
+}
+bool WriteEncodedFrames(CacheWriter& writer, TemporalEncoder& encoder, size_t rawSize)
+{
+	EncodedFrame frame;
+	while (encoder.Pop(frame))
+	{
+		// Key, Delta & Basis Payloads Deflated As a Single Entry Package
+		Package package;
+		if (IsPacked(frame.codec))
+		{
+			ScopedStage stage(opStats, "compress", frame.payload.size());
+			Zipper zipper(package);
+			RegionInStream payload(frame.payload.data(), frame.payload.size());
+			zipper.add(payload, "max-mesh.frm", compressionMode);
+			zipper.close();
+		}
+		const Package& stored = IsPacked(frame.codec) ? package : frame.payload;
+
+		ScopedStage stage(opStats, "write", stored.size());
+		if (!writer.AppendFrame(frame.time, stored.data(), stored.size(), frame.codec, rawSize)) return false;
+		opStats.AddBytes(rawSize, stored.size());
+	}
+	return true;
+}
+bool UnpackFrame(const FrameRecord& record, const unsigned char* data, vector<unsigned char>& payload)
+{
+	if (!IsPacked(record.codec)) { payload.assign(data, data + record.size); return true; }
+	RegionInStream stream(data, (size_t)record.size);
+	Unzipper unzipper(stream);
+	bool unpacked = unzipper.extractEntryToMemory("max-mesh.frm", payload);
+	unzipper.close();
+	return unpacked;
+}
+bool ReadCacheFrame(CacheReader& reader, size_t index, vector<unsigned char>& payload)
+{
+	const FrameRecord& record = reader.Frames()[index];
+	ScopedStage stage(opStats, "open", record.size);
+	if (!IsPacked(record.codec)) return reader.ReadFrame(index, payload);
+	vector<unsigned char> stored;
+	return reader.ReadFrame(index, stored) && UnpackFrame(record, stored.data(), payload);
+}
+bool CacheMeshRange(INode* node, int startFrame, int endFrame, int step, bool withNormals)
+{
+	char outputNameBuffer[MAX_PATH];
+
+	if (!node || step < 1 || endFrame < startFrame) { return false; }
+	ScopedOperation operation(opStats, "cacheRange", StatsTarget(node).c_str());
+	DebugLog(L"Caching object [%s] frames %d to %d...", node->GetName(), startFrame, endFrame);
+
+	profiler.Reset(); profiler.Start();
+	sprintf_s(outputNameBuffer, sizeof outputNameBuffer, "%s\\%S.mxa", cachePath.c_str(), node->GetName());
+	_strlwr(outputNameBuffer);
+
+	CacheWriter writer;
+	MaxMeshMetaData firstMeta;
+	unique_ptr<TemporalEncoder> encoder;
+	ScopedCharge segmentCharge(memoryLedger, LedgerStaging);
+	size_t frameSize = 0;
+	int tpf = GetTicksPerFrame();
+	for (int frame = startFrame; frame <= endFrame; frame += step)
+	{
+		TimeValue t = frame * tpf;
+		MeshCapture capture;
+		if (!CaptureMesh(node, t, capture))
+		{
+			DebugLog(L"Caching object [%s] failed at frame %d.", node->GetName(), frame);
+			return false;
+		}
+
+		// Topology & UVs Once, As a Regular Package Of The First Frame
+		if (frame == startFrame)
+		{
+			firstMeta = capture.meta;
+			withNormals = withNormals && capture.meta.nNum > 0;
+
+			CacheHeader header{};
+			header.flags = withNormals ? CacheNormals : 0;
+			header.vNum = capture.meta.vNum;
+			header.nNum = withNormals ? capture.meta.nNum : 0;
+			header.startTime = t;
+			header.stepTime = step * tpf;
+			header.topologyHash = capture.meta.topologyHash;
+			header.codec = animationCodec.codec;
+			header.keyInterval = animationCodec.keyInterval;
+			header.positionStep = animationCodec.positionStep;
+			header.normalStep = animationCodec.normalStep;
+
+			// Basis Segments Are Held Whole Until Encoded
+			encoder = make_unique<TemporalEncoder>(animationCodec, (size_t)header.vNum * 3, (size_t)header.nNum * 3);
+			frameSize = ((size_t)header.vNum + header.nNum) * sizeof(Point3);
+			segmentCharge.Resize(encoder->SegmentBytes());
+			if (!IsMemoryGranted(segmentCharge, L"codec segment")) return false;
+
+			Package package;
+			WriteMeshPackage(capture, package);
+			RecordPackageStats(package);
+			ScopedStage stage(opStats, "write", package.size());
+			if (!writer.Open(path(outputNameBuffer), header) || !writer.WriteTopology(package.data(), package.size()))
+			{
+				DebugLog(L"Caching object [%s] failed, %S is not writable.", node->GetName(), outputNameBuffer);
+				return false;
+			}
+		}
+
+		// Every Frame Must Share The Cached Topology
+		if (!IsSameTopology(firstMeta, capture.meta) || (withNormals && capture.meta.nNum != firstMeta.nNum))
+		{
+			DebugLog(L"Caching object [%s] failed, topology changes at frame %d.", node->GetName(), frame);
+			return false;
+		}
+
+		// Positions, Then Normals
+		const MeshChannelView* vertices = FindChannel(capture, "max-mesh.vtx");
+		const MeshChannelView* normals = withNormals ? FindChannel(capture, "max-mesh.nrm") : nullptr;
+		BUFFER buffer;
+		if (!AcquireStaging(buffer, frameSize)) return false;
+		buffer.resize(frameSize);
+		memcpy(buffer.data(), vertices->data, vertices->size);
+		if (normals) memcpy(buffer.data() + vertices->size, normals->data, normals->size);
+		{
+			ScopedStage stage(opStats, "encode", frameSize);
+			encoder->Push(t, (const float*)buffer.data());
+		}
+		BUFFER_FREE(buffer);
+		if (!WriteEncodedFrames(writer, *encoder, frameSize))
+		{
+			DebugLog(L"Caching object [%s] failed, %S is not writable.", node->GetName(), outputNameBuffer);
+			return false;
+		}
+	}
+
+	// Last Partial Segment
+	{
+		ScopedStage stage(opStats, "encode");
+		encoder->Finish();
+	}
+	if (!WriteEncodedFrames(writer, *encoder, frameSize))
+	{
+		DebugLog(L"Caching object [%s] failed, %S is not writable.", node->GetName(), outputNameBuffer);
+		return false;
+	}
+	const ErrorStats& error = encoder->Error();
+	writer.Header().maxError = (float)error.maxError;
+	writer.Header().rmsError = (float)error.Rms();
+	opStats.SetError(error.maxError, error.Rms());
+
+	if (!writer.Close())
+	{
+		DebugLog(L"Caching object [%s] failed, %S could not be finalized.", node->GetName(), outputNameBuffer);
+		return false;
+	}
+
+	DebugLog(L"Object [%s] frames %d to %d successfully cached to %S in %f ms (%llu KB, %s, max error %f, rms error %f)", node->GetName(), startFrame, endFrame,
+		outputNameBuffer, profiler.ElapsedMilliseconds(), (unsigned long long)(writer.Size() >> 10), CodecName(animationCodec.codec), error.maxError, error.Rms());
+	operation.Succeed();
+	return true;
+}
+bool RestoreFrameFromCache(const wchar_t* mxa_package, INode* node, int frame)
+{
+	if (!node) { return false; }
+	profiler.Reset(); profiler.Start();
+
+	// Convert Package Name
+	wstring mxa_package_ws(mxa_package);
+	string mxa_package_str(mxa_package_ws.begin(), mxa_package_ws.end());
+	ScopedOperation operation(opStats, "restoreFrame", mxa_package_str.c_str());
+
+	// Editable Poly Targets Only
+	Object* base = node->GetObjectRef()->FindBaseObject();
+	if (base->SuperClassID() != GEOMOBJECT_CLASS_ID || base->ClassID() != EPOLYOBJ_CLASS_ID) return false;
+	PolyObject* obj = (PolyObject*)base;
+
+	CacheReader reader;
+	if (!reader.Open(path(mxa_package_str)) || reader.Frames().empty())
+	{
+		DebugLog(L"Restoring frame from [%s] failed, animated cache not found.", mxa_package);
+		return false;
+	}
+	const CacheHeader& header = reader.Header();
+	size_t index = reader.FrameAt(frame * GetTicksPerFrame());
+
+	theHold.Begin();
+	MNMesh& mesh = obj->GetMesh();
+
+	// Different Topology, Rebuilt From The Embedded Package First
+	bool rebuilt = mesh.numv != header.vNum || (header.topologyHash && HashTopology(mesh) != header.topologyHash);
+	if (rebuilt)
+	{
+		auto package = make_shared<Package>();
+		bool read = false;
+		{
+			ScopedStage stage(opStats, "open", header.topologySize);
+			read = reader.ReadTopology(*package);
+		}
+		RestoreMeshOp* undo = read ? new RestoreMeshOp(obj, mxa_package, package) : nullptr;
+		if (!undo || !undo->Accounted())
+		{
+			delete undo; theHold.Cancel();
+			DebugLog(L"Restoring frame from [%s] failed.", mxa_package);
+			return false;
+		}
+		theHold.Put(undo);
+
+		RegionInStream stream(package->data(), package->size());
+		Unzipper unzipper(stream);
+		RecordPackageStats(unzipper);
+		if (!DecodePolyPackage(unzipper, mesh) || mesh.numv != header.vNum)
+		{
+			theHold.Cancel();
+			obj->NotifyDependents(FOREVER, ALL_CHANNELS, REFMSG_CHANGE);
+			DebugLog(L"Restoring frame from [%s] failed, topology package could not be decoded.", mxa_package);
+			return false;
+		}
+	}
+
+	// Frame Stream, Delta Chains & Basis Segments Decoded From Their Key
+	BUFFER buffer;
+	const FrameRecord& record = reader.Frames()[index];
+	TemporalDecoder decoder(header, reader.Frames().data(), reader.Frames().size());
+	bool read = AcquireStaging(buffer, decoder.FrameFloats() * sizeof(float));
+	if (read)
+	{
+		ScopedStage stage(opStats, "decode", record.rawSize);
+		buffer.resize(decoder.FrameFloats() * sizeof(float));
+		read = decoder.Decode(index, [&](size_t i, vector<unsigned char>& payload) { return ReadCacheFrame(reader, i, payload); }, (float*)buffer.data());
+	}
+	MNNormalSpec* mesh_ns = mesh.GetSpecifiedNormals();
+	bool withNormals = (header.flags & CacheNormals) && mesh_ns && mesh_ns->GetNumNormals() == header.nNum &&
+		buffer.size() >= (header.vNum + (size_t)header.nNum) * sizeof(Point3);
+	RestoreVertsOp* undo = read ? new RestoreVertsOp(obj, withNormals) : nullptr;
+	if (!undo || !undo->Accounted())
+	{
+		delete undo; BUFFER_FREE(buffer);
+		theHold.Cancel();
+		obj->NotifyDependents(FOREVER, ALL_CHANNELS, REFMSG_CHANGE);
+		DebugLog(L"Restoring frame from [%s] failed, frame %d could not be read.", mxa_package, frame);
+		return false;
+	}
+	theHold.Put(undo);
+	opStats.AddBytes(record.rawSize, record.size);
+
+	// Positions & Normals In Place
+	{
+		ScopedStage stage(opStats, "copy", buffer.size());
+		const Point3* points = (const Point3*)buffer.data();
+		RestoreLoop(header.vNum, header.vNum * sizeof(Point3), [&](size_t i) { mesh.v[i].p = points[i]; });
+		if (withNormals)
+		{
+			const Point3* normals = points + header.vNum;
+			RestoreLoop(header.nNum, header.nNum * sizeof(Point3), [&](size_t i) { mesh_ns->Normal((int)i) = normals[i]; });
+		}
+		else if (mesh_ns)
+		{
+			mesh_ns->SetFlag(MNNORMAL_NORMALS_COMPUTED, false);
+		}
+	}
+	BUFFER_FREE(buffer);
+
+	// Update
+	mesh.InvalidateGeomCache();
+	obj->NotifyDependents(FOREVER, rebuilt ? ALL_CHANNELS : PART_GEOM, REFMSG_CHANGE);
+	{
+		ScopedStage stage(opStats, "redraw");
+		GetCOREInterface()->RedrawViews(GetCOREInterface()->GetTime());
+	}
+	theHold.Accept(L"MXMesh :: RestoreFrame");
+
+	DebugLog(L"Frame %d of [%s] restored to %s in %f ms", frame, mxa_package, node->GetName(), profiler.ElapsedMilliseconds());
+	operation.Succeed();
+	return true;
+}
+
+// Animated Playback
+struct PlaybackBinding
+{
+	ULONG handle;
+	wstring file;
+	MappedFile mapping;
+	CacheView view;
+	unique_ptr<TemporalDecoder> decoder;		// Prefetching Worker
+	unique_ptr<TemporalDecoder> missDecoder;	// Ring Misses On The Main Thread, Never Waits Behind The Worker
+	unique_ptr<FrameRing> ring;
+	size_t lastFrame = SIZE_MAX;
+	uint64_t applied = 0;
+	double applyMilliseconds = 0;
+};
+class PlaybackTimeCallback : public TimeChangeCallback
+{
+public:
+	void TimeChanged(TimeValue t);
+};
+vector<unique_ptr<PlaybackBinding>> playbacks;
+PlaybackTimeCallback playbackCallback;
+bool playbackRegistered = false;
+UINT_PTR playbackReleaseTimer = 0;
+bool DecodePlaybackFrame(PlaybackBinding& binding, size_t index, Frame& frame)
+{
+	// Copied Off The Mapping, Page Faults Land On The Prefetching Thread
+	const CacheView& view = binding.view;
+	const FrameRecord& record = view.Frame(index);
+	TraceScope trace("decodeFrame", "playback");
+	if (record.codec == CodecRaw)
+	{
+		frame.assign(view.FrameData(index), view.FrameData(index) + record.size);
+		return true;
+	}
+
+	// Prefetching In Order Continues The Decoder's Chain, Seeks Restart From a Key
+	TemporalDecoder& decoder = this_thread::get_id() == mainThreadId ? *binding.missDecoder : *binding.decoder;
+	frame.resize(decoder.FrameFloats() * sizeof(float));
+	return decoder.Decode(index, [&](size_t i, vector<unsigned char>& payload) { return UnpackFrame(view.Frame(i), view.FrameData(i), payload); },
+		(float*)frame.data());
+}
+PolyObject* PlaybackTarget(INode* node, const CacheHeader& header)
+{
+	if (!node) return nullptr;
+	Object* base = node->GetObjectRef()->FindBaseObject();
+	if (base->SuperClassID() != GEOMOBJECT_CLASS_ID || base->ClassID() != EPOLYOBJ_CLASS_ID) return nullptr;
+	PolyObject* obj = (PolyObject*)base;
+	return obj->GetMesh().numv == header.vNum ? obj : nullptr;
+}
+void ApplyPlaybackFrame(PlaybackBinding& binding, PolyObject* obj, const Frame& frame)
+{
+	const CacheHeader& header = binding.view.Header();
+	if (frame.size() < header.vNum * sizeof(Point3)) return;
+	TraceScope trace("applyFrame", "playback");
+	auto start = chrono::steady_clock::now();
+
+	// Positions & Normals In Place, Playback Is Never Held For Undo
+	MNMesh& mesh = obj->GetMesh();
+	MNNormalSpec* mesh_ns = mesh.GetSpecifiedNormals();
+	const Point3* points = (const Point3*)frame.data();
+	RestoreLoop(header.vNum, header.vNum * sizeof(Point3), [&](size_t i) { mesh.v[i].p = points[i]; });
+	bool withNormals = (header.flags & CacheNormals) && mesh_ns && mesh_ns->GetNumNormals() == header.nNum &&
+		frame.size() >= (header.vNum + (size_t)header.nNum) * sizeof(Point3);
+	if (withNormals)
+	{
+		const Point3* normals = points + header.vNum;
+		RestoreLoop(header.nNum, header.nNum * sizeof(Point3), [&](size_t i) { mesh_ns->Normal((int)i) = normals[i]; });
+	}
+	else if (mesh_ns)
+	{
+		mesh_ns->SetFlag(MNNORMAL_NORMALS_COMPUTED, false);
+	}
+	mesh.InvalidateGeomCache();
+	obj->NotifyDependents(FOREVER, PART_GEOM, REFMSG_CHANGE);
+
+	binding.applied++;
+	binding.applyMilliseconds += ElapsedMilliseconds(start);
+}
+void StopPlayback(INode* node)
+{
+	// Rings Join Their Workers On Destruction
+	for (auto it = playbacks.begin(); it != playbacks.end();)
+		it = !node || (*it)->handle == node->GetHandle() ? playbacks.erase(it) : it + 1;
+	if (playbacks.empty() && playbackRegistered)
+	{
+		maxInterface->UnRegisterTimeChangeCallback(&playbackCallback);
+		playbackRegistered = false;
+	}
+}
+void CALLBACK PlaybackReleaseTimerProc(HWND, UINT, UINT_PTR, DWORD)
+{
+	KillTimer(NULL, playbackReleaseTimer);
+	playbackReleaseTimer = 0;
+	if (playbacks.empty()) StopPlayback(nullptr);
+}
+void PlaybackTimeCallback::TimeChanged(TimeValue t)
+{
+	for (auto it = playbacks.begin(); it != playbacks.end();)
+	{
+		PlaybackBinding& binding = **it;
+		PolyObject* obj = PlaybackTarget(maxInterface->GetINodeByHandle(binding.handle), binding.view.Header());
+		if (!obj)
+		{
+			DebugLog(L"Playback of [%s] stopped, target node was deleted or its topology changed.", binding.file.c_str());
+			it = playbacks.erase(it);
+			continue;
+		}
+
+		// Direction From The Step, Long Jumps Backwards Are Looped Playback Wrapping Around
+		size_t index = binding.view.FrameAt(t);
+		if (index != binding.lastFrame)
+		{
+			int direction = 1;
+			if (binding.lastFrame != SIZE_MAX)
+			{
+				long long delta = (long long)index - (long long)binding.lastFrame;
+				if ((size_t)llabs(delta) > binding.view.FrameCount() / 2) delta = -delta;
+				direction = delta > 0 ? 1 : -1;
+			}
+			SharedFrame frame = binding.ring->Acquire(index, direction);
+			if (frame) ApplyPlaybackFrame(binding, obj, *frame);
+			binding.lastFrame = index;
+		}
+		++it;
+	}
+
+	// Unregistering While Max Walks Its Callback List Is Unsafe, Left To The Timer
+	if (playbacks.empty() && !playbackReleaseTimer) playbackReleaseTimer = SetTimer(NULL, 0, 0, PlaybackReleaseTimerProc);
+}
+bool StartPlayback(const wchar_t* mxa_package, INode* node)
+{
+	if (!node) { return false; }
+	DebugLog(L"Starting playback of [%s] on %s...", mxa_package, node->GetName());
+	EnsureCalibration();
+
+	auto binding = make_unique<PlaybackBinding>();
+	binding->handle = node->GetHandle();
+	binding->file = mxa_package;
+	if (!binding->mapping.Open(mxa_package) || !binding->view.Open(binding->mapping.Data(), binding->mapping.Size()) || !binding->view.FrameCount())
+	{
+		DebugLog(L"Playback of [%s] failed, animated cache not found or damaged.", mxa_package);
+		return false;
+	}
+
+	// Different Topology, Rebuilt Once From The Cache Itself
+	const CacheHeader& header = binding->view.Header();
+	PolyObject* obj = PlaybackTarget(node, header);
+	if (!obj || (header.topologyHash && HashTopology(obj->GetMesh()) != header.topologyHash))
+	{
+		if (!RestoreFrameFromCache(mxa_package, node, GetCOREInterface()->GetTime() / GetTicksPerFrame())) return false;
+		if (!PlaybackTarget(node, header)) return false;
+	}
+
+	PlaybackBinding* bound = binding.get();
+	binding->decoder = make_unique<TemporalDecoder>(header, &binding->view.Frame(0), binding->view.FrameCount());
+	binding->missDecoder = make_unique<TemporalDecoder>(header, &binding->view.Frame(0), binding->view.FrameCount());
+	binding->ring = make_unique<FrameRing>(binding->view.FrameCount(), playbackRingFrames, playbackLookahead,
+		[bound](size_t index, Frame& frame) { return DecodePlaybackFrame(*bound, index, frame); });
+
+	StopPlayback(node);
+	if (!playbackRegistered) maxInterface->RegisterTimeChangeCallback(&playbackCallback);
+	playbackRegistered = true;
+	playbacks.push_back(move(binding));
+
+	// Current Frame Right Away, Not On The Next Time Change
+	playbackCallback.TimeChanged(GetCOREInterface()->GetTime());
+	GetCOREInterface()->RedrawViews(GetCOREInterface()->GetTime());
+	DebugLog(L"Playback of [%s] bound to %s, %d frames.", mxa_package, node->GetName(), (int)header.frameCount);
+	return true;
+}
+
+// Progressive Restore
+struct ProgressiveRestore
+{
+	wstring file;
+	ULONG handle = 0;			// The Node May Be Deleted Before The Mesh Lands
+	BYTE target = RESTORE_TARGET_EDITABLE_POLY;
+	Object* proxy = nullptr;
+	Object* full = nullptr;		// Referenced By Nothing Until Swapped In, Only The Worker Touches It
+	PackageReader reader;
+	MaxMeshMetaData meta;
+	future<bool> decoded;
+	chrono::steady_clock::time_point queued;
+};
+deque<unique_ptr<ProgressiveRestore>> progressiveQueue;
+vector<unique_ptr<ProgressiveRestore>> progressiveRunning;
+size_t progressiveWorkers = max<size_t>(1, thread::hardware_concurrency() / 2);
+UINT_PTR progressiveTimer = 0;
+void BuildBoxMesh(MNMesh& mesh, const Box3& bounds)
+{
+	mesh.ClearAndFree();
+	for (int i = 0; i < 8; i++)
+	{
+		Point3 corner(i & 1 ? bounds.pmax.x : bounds.pmin.x, i & 2 ? bounds.pmax.y : bounds.pmin.y, i & 4 ? bounds.pmax.z : bounds.pmin.z);
+		mesh.NewVert(corner);
+	}
+	static int quads[6][4] = { { 0, 2, 3, 1 }, { 4, 5, 7, 6 }, { 0, 1, 5, 4 }, { 2, 6, 7, 3 }, { 0, 4, 6, 2 }, { 1, 3, 7, 5 } };
+	for (auto& quad : quads) mesh.NewFace(0, 4, quad);
+	mesh.FillInMesh();
+}
+bool ReadVertexBounds(Unzipper& unzipper, const MaxMeshMetaData& meshMeta, Box3& bounds)
+{
+	// Legacy Headers Carry No Bounds, Only The Vertex Channel Is Inflated
+	BUFFER buffer;
+	bounds.Init();
+	if (!ExtractChannel(unzipper, "max-mesh.vtx", buffer, meshMeta.vNum * sizeof(Point3))) { BUFFER_FREE(buffer); return false; }
+	const Point3* points = (const Point3*)buffer.data();
+	for (int i = 0; i < meshMeta.vNum; i++) bounds += points[i];
+	BUFFER_FREE(buffer);
+	return true;
+}
+bool BuildProxyMesh(Unzipper& unzipper, const MaxMeshMetaData& meshMeta, MNMesh& mesh)
+{
+	ScopedStage stage(opStats, "proxy");
+
+	// Coarsest Stored Level When The Package Carries Any
+	int level = FindLodLevel(unzipper, MAX_LOD_LEVELS);
+	if (level)
+	{
+		Package package;
+		if (unzipper.extractEntryToMemory(LodEntry(level), package))
+		{
+			RegionInStream stream(package.data(), package.size());
+			Unzipper lodUnzipper(stream);
+			if (DecodePolyPackage(lodUnzipper, mesh)) return true;
+		}
+	}
+
+	// Otherwise a Box Around The Mesh
+	Box3 bounds = meshMeta.bounds;
+	if (meshMeta.version < 4 && !ReadVertexBounds(unzipper, meshMeta, bounds)) return false;
+	BuildBoxMesh(mesh, bounds);
+	return true;
+}
+bool DecodeProgressiveRestore(ProgressiveRestore& job)
+{
+	// Worker Thread, Nothing Here May Touch The Scene
+	TraceScope trace("progressive", "restore");
+	Unzipper& unzipper = *job.reader.unzipper;
+	bool decoded = job.target == RESTORE_TARGET_EDITABLE_MESH ?
+		BuildMeshFromCache(unzipper, job.meta, ((TriObject*)job.full)->GetMesh()) :
+		BuildPolyFromCache(unzipper, job.meta, ((PolyObject*)job.full)->GetMesh());
+	unzipper.close();
+	return decoded;
+}
+void LaunchProgressiveRestores()
+{
+	// Bounded, Hundreds Of Queued Assets Never Inflate All At Once
+	while (!progressiveQueue.empty() && progressiveRunning.size() < progressiveWorkers)
+	{
+		ProgressiveRestore* job = progressiveQueue.front().get();
+		job->decoded = async(launch::async, [job]() { return DecodeProgressiveRestore(*job); });
+		progressiveRunning.push_back(move(progressiveQueue.front()));
+		progressiveQueue.pop_front();
+	}
+}
+bool SwapProgressiveRestore(ProgressiveRestore& job)
+{
+	// Proxy Replaced Where It Sits, Modifiers Added Meanwhile Stay On Top
+	bool decoded = job.decoded.get();
+	INode* node = decoded ? maxInterface->GetINodeByHandle(job.handle) : nullptr;
+	bool swapped = false;
+	if (node && node->GetObjectRef() == job.proxy)
+	{
+		node->SetObjectRef(job.full);
+		swapped = true;
+	}
+	for (Object* ref = node ? node->GetObjectRef() : nullptr; !swapped && ref && ref->SuperClassID() == GEN_DERIVOB_CLASS_ID;)
+	{
+		IDerivedObject* derived = (IDerivedObject*)ref;
+		if (derived->GetObjRef() == job.proxy) { derived->ReferenceObject(job.full); swapped = true; }
+		ref = derived->GetObjRef();
+	}
+
+	if (!swapped)
+	{
+		job.full->MaybeAutoDelete();
+		DebugLog(L"Progressive restore of [%s] %s.", job.file.c_str(), decoded ? L"dropped, its proxy was deleted or replaced" : L"failed, proxy kept");
+		return false;
+	}
+	job.full->NotifyDependents(FOREVER, ALL_CHANNELS, REFMSG_CHANGE);
+	DebugLog(L"Cache [%s] streamed into %s after %f ms", job.file.c_str(), node->GetName(), ElapsedMilliseconds(job.queued));
+	return true;
+}
+size_t FinishProgressiveRestores(bool wait)
+{
+	size_t swapped = 0;
+	for (;;)
+	{
+		LaunchProgressiveRestores();
+		if (progressiveRunning.empty()) break;
+
+		// Finished Jobs Swapped In, Blocking Only When Asked To
+		bool finished = false;
+		for (auto it = progressiveRunning.begin(); it != progressiveRunning.end();)
+		{
+			if ((*it)->decoded.wait_for(chrono::seconds(0)) != future_status::ready) { ++it; continue; }
+			if (SwapProgressiveRestore(**it)) swapped++;
+			it = progressiveRunning.erase(it);
+			finished = true;
+		}
+		if (!wait) break;
+		if (!finished) progressiveRunning.front()->decoded.wait();
+	}
+	if (swapped) GetCOREInterface()->RedrawViews(GetCOREInterface()->GetTime());
+	return swapped;
+}
+void CALLBACK ProgressiveTimerProc(HWND, UINT, UINT_PTR, DWORD)
+{
+	FinishProgressiveRestores(false);
+	if (!progressiveRunning.empty() || !progressiveQueue.empty()) return;
+	KillTimer(NULL, progressiveTimer);
+	progressiveTimer = 0;
+}
+void CancelProgressiveRestores()
+{
+	// Queued Jobs Keep Their Proxies, Running Ones Must Finish Before Unloading
+	for (auto& job : progressiveRunning) job->decoded.wait();
+
+	// Full Objects Were Never Referenced, Nothing Else Would Free Them
+	for (auto& job : progressiveQueue) job->full->MaybeAutoDelete();
+	for (auto& job : progressiveRunning) job->full->MaybeAutoDelete();
+	progressiveQueue.clear();
+	progressiveRunning.clear();
+	if (progressiveTimer) KillTimer(NULL, progressiveTimer);
+	progressiveTimer = 0;
+}
+bool GenerateProxyNodeFromCache(const wchar_t* mxm_package, int lod, BYTE channels)
+{
+	profiler.Reset(); profiler.Start();
+	DebugLog(L"Restoring proxy from cache file [%s]...", mxm_package);
+
+	// Convert Package Name
+	wstring mxm_package_ws(mxm_package);
+	string mxm_package_str(mxm_package_ws.begin(), mxm_package_ws.end());
+	ScopedOperation operation(opStats, "restoreProxy", mxm_package_str.c_str());
+
+	// Header Only, The Reader Is Handed To The Worker Afterwards
+	auto job = make_unique<ProgressiveRestore>();
+	if (!OpenPackage(mxm_package_str, lod, job->reader))
+	{
+		DebugLog(L"Restoring cache [%s] failed, package not found.", mxm_package);
+		return false;
+	}
+	Unzipper& unzipper = *job->reader.unzipper;
+	PolyObject* proxy = (PolyObject*)CreateInstance(GEOMOBJECT_CLASS_ID, EPOLYOBJ_CLASS_ID);
+	if (!ReadMetaFromCache(unzipper, job->meta) || !BuildProxyMesh(unzipper, job->meta, proxy->GetMesh()))
+	{
+		unzipper.close();
+		proxy->MaybeAutoDelete();
+		DebugLog(L"Restoring cache [%s] failed.", mxm_package);
+		return false;
+	}
+
+	// Node Right Away
+	TimeValue t = GetCOREInterface()->GetTime();
+	INode* newNode = maxInterface->CreateObjectNode(proxy);
+	newNode->SetName(StringGetWideChar(job->meta.name));
+	newNode->SetNodeTM(t, job->meta.tm);
+	newNode->SetWireColor(job->meta.col);
+	proxy->NotifyDependents(FOREVER, ALL_CHANNELS, REFMSG_CHANGE);
+
+	// Full Object Created Here, Filled On a Worker
+	job->meta = SelectChannels(job->meta, channels);
+	job->file = mxm_package;
+	job->handle = newNode->GetHandle();
+	job->target = restoreTarget;
+	job->proxy = proxy;
+	job->queued = chrono::steady_clock::now();
+	if (job->target == RESTORE_TARGET_EDITABLE_MESH) job->full = (Object*)CreateInstance(GEOMOBJECT_CLASS_ID, triobjectCID);
+	else job->full = (Object*)CreateInstance(GEOMOBJECT_CLASS_ID, EPOLYOBJ_CLASS_ID);
+	progressiveQueue.push_back(move(job));
+	LaunchProgressiveRestores();
+	if (!progressiveTimer) progressiveTimer = SetTimer(NULL, 0, PROGRESSIVE_POLL_INTERVAL, ProgressiveTimerProc);
+
+	{
+		ScopedStage stage(opStats, "redraw");
+		GetCOREInterface()->RedrawViews(t);
+	}
+	TouchCatalogPackage(mxm_package);
+	DebugLog(L"Proxy of [%s] created as %s in %f ms, %d restores pending.",
+		mxm_package, newNode->GetName(), profiler.ElapsedMilliseconds(), (int)(progressiveQueue.size() + progressiveRunning.size()));
+
+	operation.Succeed();
+	return true;
+}
+bool GenerateRegionFromCache(const wchar_t* mxm_package, const Box3& worldRegion, BYTE channels)
+{
+	profiler.Reset(); profiler.Start();
+	DebugLog(L"Restoring region of cache file [%s]...", mxm_package);
+
+	// Convert Package Name
+	wstring mxm_package_ws(mxm_package);
+	string mxm_package_str(mxm_package_ws.begin(), mxm_package_ws.end());
+	ScopedOperation operation(opStats, "restoreRegion", mxm_package_str.c_str());
+
+	PackageReader reader;
+	if (!OpenPackage(mxm_package_str, reader))
+	{
+		DebugLog(L"Restoring cache [%s] failed, package not found.", mxm_package);
+		return false;
+	}
+	Unzipper& unzipper = *reader.unzipper;
+	MaxMeshMetaData meshMeta;
+	vector<MaxMeshChunk> index;
+	if (!ReadMetaFromCache(unzipper, meshMeta) || !IsChunkedPackage(unzipper) || !ReadChunkIndex(unzipper, index))
+	{
+		unzipper.close();
+		DebugLog(L"Restoring region of cache [%s] failed, package is not spatially chunked.", mxm_package);
+		return false;
+	}
+
+	// Cells Are Bounded In Object Space, The World Box Is Taken Into It Through The Captured Transform
+	Matrix3 inverse = Inverse(meshMeta.tm);
+	Box3 region;
+	region.Init();
+	for (int k = 0; k < 8; k++) region += worldRegion[k] * inverse;
+
+	// Charged By The Overlapping Cells Alone, Ids Stay Those Of The Whole Mesh
+	MaxMeshMetaData selectedMeta = SelectChannels(meshMeta, channels);
+	MaxMeshMetaData regionMeta = selectedMeta;
+	regionMeta.vNum = regionMeta.fNum = regionMeta.cNum = 0;
+	int tNum = 0, nNum = 0;
+	for (size_t c : SelectChunks(index, &region))
+	{
+		regionMeta.vNum += index[c].vNum;
+		regionMeta.fNum += index[c].fNum;
+		regionMeta.cNum += index[c].cNum;
+		tNum += index[c].tNum;
+		nNum += index[c].nNum;
+	}
+	if (regionMeta.tNum) regionMeta.tNum = tNum;
+	if (regionMeta.nNum) regionMeta.nNum = nNum;
+	if (!regionMeta.fNum)
+	{
+		unzipper.close();
+		DebugLog(L"Region holds no faces of cache [%s].", mxm_package);
+		return false;
+	}
+
+	TimeValue t = GetCOREInterface()->GetTime();
+	Object* obj = nullptr;
+	bool restored = false;
+	{
+		ScopedStage stage(opStats, "build");
+		ScopedCharge meshCharge(memoryLedger, LedgerMeshes, PolyMeshBytes(regionMeta));
+		if (IsMemoryGranted(meshCharge, L"decoded region"))
+		{
+			PolyObject* pobj = (PolyObject*)CreateInstance(GEOMOBJECT_CLASS_ID, EPOLYOBJ_CLASS_ID);
+			restored = DecodeChunkedPoly(unzipper, selectedMeta, pobj->GetMesh(), &region);
+			obj = pobj;
+			if (restored && restoreTarget == RESTORE_TARGET_EDITABLE_MESH)
+			{
+				ScopedStage outToTri(opStats, "outToTri");
+				TriObject* tobj = (TriObject*)CreateInstance(GEOMOBJECT_CLASS_ID, triobjectCID);
+				pobj->GetMesh().OutToTri(tobj->GetMesh());
+				pobj->MaybeAutoDelete();
+				obj = tobj;
+			}
+		}
+	}
+	unzipper.close();
+	if (!restored)
+	{
+		if (obj) obj->MaybeAutoDelete();
+		DebugLog(L"Restoring region of cache [%s] failed.", mxm_package);
+		return false;
+	}
+
+	// Set Configs
+	INode* newNode = maxInterface->CreateObjectNode(obj);
+	newNode->SetName(StringGetWideChar(meshMeta.name));
+	newNode->SetNodeTM(t, meshMeta.tm);
+	newNode->SetWireColor(meshMeta.col);
+	{
+		ScopedStage stage(opStats, "redraw");
+		GetCOREInterface()->RedrawViews(t);
+	}
+	obj->NotifyDependents(FOREVER, ALL_CHANNELS, REFMSG_CHANGE);
+
+	TouchCatalogPackage(mxm_package);
+	DebugLog(L"Region of cache [%s] restored to %s, %d of %d faces in %f ms",
+		mxm_package, newNode->GetName(), regionMeta.fNum, meshMeta.fNum, profiler.ElapsedMilliseconds());
+
+	operation.Succeed();
+	return true;
+}
+
+// Maxscript Exposed API
+MaxMeshMXS(Cache, "Cache");
+Value* Cache_api(Value** arg_list, int count)
+{
+	if (count == 1)
+	{
+		INode* node = arg_list[0]->to_node();
+		if (CacheMeshToDisk(node)) return &true_value;
+		else return &false_value;
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.Cache <node>"); return &false_value;
+	}
+}
+MaxMeshMXS(CacheRange, "CacheRange");
+Value* CacheRange_api(Value** arg_list, int count)
+{
+	if (count >= 3 && count <= 5)
+	{
+		INode* node = arg_list[0]->to_node();
+		int step = count >= 4 && !is_name(arg_list[3]) ? arg_list[3]->to_int() : 1;
+		bool withNormals = is_name(arg_list[count - 1]) && wcscmp(arg_list[count - 1]->to_string(), L"normals") == 0;
+		if (CacheMeshRange(node, arg_list[1]->to_int(), arg_list[2]->to_int(), step, withNormals)) return &true_value;
+		else return &false_value;
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.CacheRange <node> <start> <end> [step] [#normals]"); return &false_value;
+	}
+}
+MaxMeshMXS(SetCacheLods, "SetCacheLods");
+Value* SetCacheLods_api(Value** arg_list, int count)
+{
+	if (count == 1 || count == 2)
+	{
+		cacheLodLevels = min(max(arg_list[0]->to_int(), 0), MAX_LOD_LEVELS);
+		if (count == 2) cacheLodRatio = min(max(arg_list[1]->to_float(), 0.01f), 0.9f);
+		DebugLog(L"MXMesh : Caching stores %d LOD levels, each keeping %f of the triangles of the one above.", cacheLodLevels, cacheLodRatio);
+		return &ok;
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.SetCacheLods <levels> [<ratio>]"); return &false_value;
+	}
+}
+MaxMeshMXS(SetCacheChunks, "SetCacheChunks");
+Value* SetCacheChunks_api(Value** arg_list, int count)
+{
+	if (count == 1)
+	{
+		cacheChunkCells = min(max(arg_list[0]->to_int(), 0), MAX_CHUNK_CELLS);
+		DebugLog(L"MXMesh : Caching splits meshes into %d cells per axis, 0 stores them whole.", cacheChunkCells);
+		return &ok;
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.SetCacheChunks <cellsPerAxis>"); return &false_value;
+	}
+}
+MaxMeshMXS(SetCacheReorder, "SetCacheReorder");
+Value* SetCacheReorder_api(Value** arg_list, int count)
+{
+	if (count == 1)
+	{
+		cacheReorder = arg_list[0]->to_bool();
+		DebugLog(L"MXMesh : Caching %s vertices and faces for locality.", cacheReorder ? L"reorders" : L"keeps the order of");
+		return &ok;
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.SetCacheReorder <bool>"); return &false_value;
+	}
+}
+MaxMeshMXS(SetAnimationCodec, "SetAnimationCodec");
+Value* SetAnimationCodec_api(Value** arg_list, int count)
+{
+	if (count >= 1 && count <= 3)
+	{
+		auto option = arg_list[0]->to_string();
+		if (wcscmp(option, L"raw") == 0) animationCodec.codec = CodecRaw;
+		else if (wcscmp(option, L"delta") == 0) animationCodec.codec = CodecDelta;
+		else if (wcscmp(option, L"basis") == 0) animationCodec.codec = CodecBasis;
+		else return &false_value;
+
+		// Precision Is The Delta Quantization Step, Or The RMS Error a Basis Segment May Leave
+		if (count >= 2) animationCodec.keyInterval = (uint32_t)max(arg_list[1]->to_int(), 1);
+		if (count == 3) animationCodec.positionStep = animationCodec.basisTolerance = max(arg_list[2]->to_float(), 1e-6f);
+		DebugLog(L"MXMesh : Animation codec has been set to %s, keyframe every %d frames, precision %f.", CodecName(animationCodec.codec),
+			(int)animationCodec.keyInterval, animationCodec.codec == CodecBasis ? animationCodec.basisTolerance : animationCodec.positionStep);
+		return &ok;
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.SetAnimationCodec [#raw][#delta][#basis] [<key_interval>] [<precision>]"); return &false_value;
+	}
+}
+MaxMeshMXS(Checkpoint, "Checkpoint");
+Value* Checkpoint_api(Value** arg_list, int count)
+{
+	if (count == 1 || count == 2)
+	{
+		INode* node = arg_list[0]->to_node();
+		bool memory = count == 2 && wcscmp(arg_list[1]->to_string(), L"memory") == 0;
+		if (memory ? CheckpointToMemory(node) : CacheMeshToDisk(node, true)) return &true_value;
+		else return &false_value;
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.Checkpoint <node> [#disk][#memory]"); return &false_value;
+	}
+}
+MaxMeshMXS(ListMemoryCheckpoints, "ListMemoryCheckpoints");
+Value* ListMemoryCheckpoints_api(Value** arg_list, int count)
+{
+	if (count == 1)
+	{
+		INode* node = arg_list[0]->to_node();
+		auto snapshots = memoryCheckpoints.List(node ? node->GetHandle() : 0);
+
+		// Package Names, Oldest First, Usable With Restore & RestoreMesh
+		one_typed_value_local(Array* result);
+		vl.result = new Array((int)snapshots.size());
+		for (auto& snapshot : snapshots)
+			vl.result->append(new String(StringGetWideChar(MemoryPackageName(snapshot.id).c_str())));
+		return_value(vl.result);
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : <array> MXMesh.ListMemoryCheckpoints <node>"); return &false_value;
+	}
+}
+MaxMeshMXS(PromoteMemoryCheckpoint, "PromoteMemoryCheckpoint");
+Value* PromoteMemoryCheckpoint_api(Value** arg_list, int count)
+{
+	if (count == 1)
+	{
+		wstring packagews(arg_list[0]->to_string());
+		uint64_t id = 0;
+		string archivePath;
+		if (!ParseMemoryPackage(string(packagews.begin(), packagews.end()), id)) return &false_value;
+		if (!PromoteMemoryCheckpoint(id, archivePath)) return &false_value;
+		return new String(StringGetWideChar(archivePath.c_str()));
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : <string> MXMesh.PromoteMemoryCheckpoint <memory_package>"); return &false_value;
+	}
+}
+MaxMeshMXS(ClearMemoryCheckpoints, "ClearMemoryCheckpoints");
+Value* ClearMemoryCheckpoints_api(Value** arg_list, int count)
+{
+	if (count == 0 || count == 1)
+	{
+		if (count == 1)
+		{
+			INode* node = arg_list[0]->to_node();
+			if (node) memoryCheckpoints.Clear(node->GetHandle());
+		}
+		else memoryCheckpoints.ClearAll();
+		return &ok;
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.ClearMemoryCheckpoints [node]"); return &false_value;
+	}
+}
+MaxMeshMXS(SetMemoryCheckpointBudget, "SetMemoryCheckpointBudget");
+Value* SetMemoryCheckpointBudget_api(Value** arg_list, int count)
+{
+	if (count == 1 || count == 2)
+	{
+		int budgetMB = max(arg_list[0]->to_int(), 0);
+		int ringSize = count == 2 ? max(arg_list[1]->to_int(), 0) : 8;
+		memoryCheckpoints.SetLimits((size_t)budgetMB << 20, (size_t)ringSize);
+		DebugLog(L"MXMesh : Memory checkpoints limited to %d MB, %d per node.", budgetMB, ringSize);
+		return &ok;
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.SetMemoryCheckpointBudget <megabytes> [<ringSize>]"); return &false_value;
+	}
+}
+MaxMeshMXS(SetUndoMode, "SetUndoMode");
+Value* SetUndoMode_api(Value** arg_list, int count)
+{
+	if (count == 1)
+	{
+		auto option = arg_list[0]->to_string();
+		if (wcscmp(option, L"full") == 0) {
+			undoMode = UNDO_MODE_FULL;
+			DebugLog(L"MXMesh : Restore undo keeps full mesh copies.");
+			return &ok;
+		}
+		if (wcscmp(option, L"compact") == 0) {
+			undoMode = UNDO_MODE_COMPACT;
+			DebugLog(L"MXMesh : Restore undo keeps compressed packages.");
+			return &ok;
+		}
+		return &false_value;
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.SetUndoMode [#compact][#full]"); return &false_value;
+	}
+}
+MaxMeshMXS(SetMemoryCheckpointMode, "SetMemoryCheckpointMode");
+Value* SetMemoryCheckpointMode_api(Value** arg_list, int count)
+{
+	if (count == 1)
+	{
+		auto option = arg_list[0]->to_string();
+		if (wcscmp(option, L"raw") == 0) {
+			memoryCheckpointMode = MEMORY_CHECKPOINT_RAW;
+			DebugLog(L"MXMesh : Memory checkpoints are stored uncompressed.");
+			return &ok;
+		}
+		if (wcscmp(option, L"compressed") == 0) {
+			memoryCheckpointMode = MEMORY_CHECKPOINT_COMPRESSED;
+			DebugLog(L"MXMesh : Memory checkpoints are stored compressed.");
+			return &ok;
+		}
+		return &false_value;
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.SetMemoryCheckpointMode [#raw][#compressed]"); return &false_value;
+	}
+}
+MaxMeshMXS(SetCachePath, "SetCachePath");
+Value* SetCachePath_api(Value** arg_list, int count)
+{
+	if (count == 1)
+	{
+		const wchar_t* cachePathVal = arg_list[0]->to_string();
+		wstring cachePathValws(cachePathVal);
+		cachePath = string(cachePathValws.begin(), cachePathValws.end());
+
+		DebugLog(L"MXMesh cache path has been set to `%s`\n", cachePathVal);
+		return &ok;
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.SetCachePath <path>"); return &false_value;
+	}
+}
+MaxMeshMXS(GetCachePath, "GetCachePath");
+Value* GetCachePath_api(Value** arg_list, int count)
+{
+	if (count == 0)
+	{
+		String* _str = new String(StringGetWideChar(cachePath.c_str()));
+		return _str;
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : <string> MXMesh.GetCachePath()"); return &false_value;
+	}
+}
+MaxMeshMXS(SetStagingPath, "SetStagingPath");
+Value* SetStagingPath_api(Value** arg_list, int count)
+{
+	if (count == 1 || count == 2)
+	{
+		wstring stagingPathws(arg_list[0]->to_string());
+		stagingPath = string(stagingPathws.begin(), stagingPathws.end());
+		if (count == 2) migrationQueue.SetStagingRetention((size_t)max(arg_list[1]->to_int(), 0) << 20);
+		if (IsStagingEnabled()) RecoverStagedPackages();
+
+		DebugLog(L"MXMesh staging path has been set to `%s` (empty = disabled)", stagingPathws.c_str());
+		return &ok;
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.SetStagingPath <path> [<retainMB>]"); return &false_value;
+	}
+}
+MaxMeshMXS(GetStagingPath, "GetStagingPath");
+Value* GetStagingPath_api(Value** arg_list, int count)
+{
+	if (count == 0)
+	{
+		return new String(StringGetWideChar(stagingPath.c_str()));
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : <string> MXMesh.GetStagingPath()"); return &false_value;
+	}
+}
+MaxMeshMXS(SetMemoryTierBudget, "SetMemoryTierBudget");
+Value* SetMemoryTierBudget_api(Value** arg_list, int count)
+{
+	if (count == 1)
+	{
+		int budgetMB = max(arg_list[0]->to_int(), 0);
+		memoryTier.SetBudget((size_t)budgetMB << 20);
+		DebugLog(L"MXMesh : Memory tier budget has been set to %d MB (0 = disabled).", budgetMB);
+		return &ok;
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.SetMemoryTierBudget <megabytes>"); return &false_value;
+	}
+}
+MaxMeshMXS(FlushMigrations, "FlushMigrations");
+Value* FlushMigrations_api(Value** arg_list, int count)
+{
+	if (count == 0)
+	{
+		// Failed Copies Get One More Attempt, Then Wait For The Archive
+		profiler.Reset(); profiler.Start();
+		migrationQueue.RetryFailed();
+		migrationQueue.Flush();
+		auto stats = migrationQueue.GetStats();
+		DebugLog(L"Migrations flushed in %f ms, %d still pending.", profiler.ElapsedMilliseconds(), (int)stats.pending);
+		return Integer::intern((int)stats.pending);
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : <integer> MXMesh.FlushMigrations()"); return &false_value;
+	}
+}
+MaxMeshMXS(GetTierStats, "GetTierStats");
+Value* GetTierStats_api(Value** arg_list, int count)
+{
+	if (count == 0)
+	{
+		auto stats = migrationQueue.GetStats();
+		pair<const wchar_t*, INT64> fields[] = {
+			{ L"memoryBytes", (INT64)memoryTier.Size() },
+			{ L"memoryPackages", (INT64)memoryTier.Count() },
+			{ L"memoryReads", (INT64)tierReads[STORAGE_TIER_MEMORY] },
+			{ L"stagingReads", (INT64)tierReads[STORAGE_TIER_STAGING] },
+			{ L"archiveReads", (INT64)tierReads[STORAGE_TIER_ARCHIVE] },
+			{ L"snapshotReads", (INT64)tierReads[STORAGE_TIER_SNAPSHOT] },
+			{ L"clipboardReads", (INT64)tierReads[STORAGE_TIER_CLIPBOARD] },
+			{ L"pendingMigrations", (INT64)stats.pending },
+			{ L"migrated", (INT64)stats.migrated },
+			{ L"migratedBytes", (INT64)stats.migratedBytes },
+			{ L"failedMigrations", (INT64)stats.failed } };
+
+		// Rows Of #(#name, value)
+		one_typed_value_local(Array* result);
+		vl.result = new Array((int)size(fields));
+		for (auto& field : fields)
+		{
+			Array* row = new Array(2);
+			row->append(Name::intern(field.first));
+			row->append(Integer64::intern(field.second));
+			vl.result->append(row);
+		}
+		return_value(vl.result);
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : <array> MXMesh.GetTierStats()"); return &false_value;
+	}
+}
+MaxMeshMXS(GetLastStats, "GetLastStats");
+Value* GetLastStats_api(Value** arg_list, int count)
+{
+	if (count == 0)
+	{
+		OperationReport report = opStats.Last();
+		auto aggregates = opStats.Aggregates();
+		auto name = [](const string& text) { return Name::intern(wstring(text.begin(), text.end()).c_str()); };
+
+		// Every Array Joins The Protected Result As Soon As It Exists, Nothing Is Left For The Collector
+		one_typed_value_local(Array* result);
+		vl.result = new Array(15);
+		auto child = [](Array* parent, int size) { Array* array = new Array(size); parent->append(array); return array; };
+		auto row = [&](const wchar_t* key) { Array* pair = child(vl.result, 2); pair->append(Name::intern(key)); return pair; };
+
+		// Stages As #(#name, ms, bytes, calls, MB/s)
+		auto stageRows = [&](Array* parent, const vector<StageStat>& stages)
+		{
+			Array* rows = child(parent, (int)stages.size());
+			for (auto& stage : stages)
+			{
+				Array* item = child(rows, 5);
+				item->append(name(stage.name));
+				item->append(Float::intern((float)stage.milliseconds));
+				item->append(Integer64::intern((INT64)stage.bytes));
+				item->append(Integer::intern((int)stage.calls));
+				item->append(Float::intern((float)MegabytesPerSecond(stage.bytes, stage.milliseconds)));
+			}
+		};
+
+		// Rows Of #(#name, value)
+		row(L"kind")->append(report.kind.empty() ? &undefined : name(report.kind));
+		row(L"target")->append(new String(wstring(report.target.begin(), report.target.end()).c_str()));
+		row(L"succeeded")->append(report.succeeded ? &true_value : &false_value);
+		row(L"milliseconds")->append(Float::intern((float)report.milliseconds));
+		row(L"rawBytes")->append(Integer64::intern((INT64)report.rawBytes));
+		row(L"packageBytes")->append(Integer64::intern((INT64)report.packageBytes));
+		row(L"mbps")->append(Float::intern((float)MegabytesPerSecond(report.rawBytes, report.milliseconds)));
+		row(L"compressionRatio")->append(Float::intern(report.packageBytes ? (float)report.rawBytes / report.packageBytes : 0.0f));
+		row(L"maxError")->append(Float::intern((float)report.maxError));
+		row(L"rmsError")->append(Float::intern((float)report.rmsError));
+		stageRows(row(L"stages"), report.stages);
+
+		// Channels As #("entry", rawBytes, compressedBytes, ms, MB/s)
+		Array* channels = child(row(L"channels"), (int)report.channels.size());
+		for (auto& channel : report.channels)
+		{
+			Array* item = child(channels, 5);
+			item->append(new String(wstring(channel.name.begin(), channel.name.end()).c_str()));
+			item->append(Integer64::intern((INT64)channel.rawBytes));
+			item->append(Integer64::intern((INT64)channel.compressedBytes));
+			item->append(Float::intern((float)channel.milliseconds));
+			item->append(Float::intern((float)MegabytesPerSecond(channel.rawBytes, channel.milliseconds)));
+		}
+		row(L"peakMemory")->append(Integer64::intern((INT64)report.peakMemory));
+
+		// Memory As #(#category, peakBytes, retainedBytes)
+		Array* memory = child(row(L"memory"), (int)report.memory.size());
+		for (auto& category : report.memory)
+		{
+			Array* item = child(memory, 3);
+			item->append(name(category.name));
+			item->append(Integer64::intern((INT64)category.peakBytes));
+			item->append(Integer64::intern((INT64)category.retainedBytes));
+		}
+
+		// Session As #(#kind, count, failed, totalMs, minMs, maxMs, rawBytes, packageBytes, MB/s, stages, maxPeakMemory)
+		Array* session = child(row(L"session"), (int)aggregates.size());
+		for (auto& aggregate : aggregates)
+		{
+			Array* item = child(session, 11);
+			item->append(name(aggregate.kind));
+			item->append(Integer64::intern((INT64)aggregate.count));
+			item->append(Integer64::intern((INT64)aggregate.failed));
+			item->append(Float::intern((float)aggregate.milliseconds));
+			item->append(Float::intern((float)aggregate.minMilliseconds));
+			item->append(Float::intern((float)aggregate.maxMilliseconds));
+			item->append(Integer64::intern((INT64)aggregate.rawBytes));
+			item->append(Integer64::intern((INT64)aggregate.packageBytes));
+			item->append(Float::intern((float)MegabytesPerSecond(aggregate.rawBytes, aggregate.milliseconds)));
+			stageRows(item, aggregate.stages);
+			item->append(Integer64::intern((INT64)aggregate.maxPeakMemory));
+		}
+		return_value(vl.result);
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : <array> MXMesh.GetLastStats()"); return &false_value;
+	}
+}
+MaxMeshMXS(ResetStats, "ResetStats");
+Value* ResetStats_api(Value** arg_list, int count)
+{
+	if (count == 0)
+	{
+		opStats.Reset();
+		memoryLedger.ResetPeaks();
+		DebugLog(L"MXMesh : Operation statistics have been reset.");
+		return &ok;
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.ResetStats()"); return &false_value;
+	}
+}
+MaxMeshMXS(StartTrace, "StartTrace");
+Value* StartTrace_api(Value** arg_list, int count)
+{
+	if (count == 0 || count == 1)
+	{
+		size_t capacity = count == 1 ? (size_t)max(arg_list[0]->to_int(), 0) : 1000000;
+		GlobalTracer().Start(capacity);
+		DebugLog(L"MXMesh : Tracing started, up to %llu events.", (unsigned long long)capacity);
+		return &ok;
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.StartTrace [<maxEvents>]"); return &false_value;
+	}
+}
+MaxMeshMXS(StopTrace, "StopTrace");
+Value* StopTrace_api(Value** arg_list, int count)
+{
+	if (count == 0)
+	{
+		GlobalTracer().Stop();
+		DebugLog(L"MXMesh : Tracing stopped, %llu events recorded, %llu dropped.",
+			(unsigned long long)GlobalTracer().EventCount(), (unsigned long long)GlobalTracer().DroppedCount());
+		return Integer64::intern((INT64)GlobalTracer().EventCount());
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : <integer> MXMesh.StopTrace()"); return &false_value;
+	}
+}
+MaxMeshMXS(ExportTrace, "ExportTrace");
+Value* ExportTrace_api(Value** arg_list, int count)
+{
+	if (count == 1)
+	{
+		wstring filews(arg_list[0]->to_string());
+		if (!GlobalTracer().ExportChromeTrace(path(filews))) return &false_value;
+		DebugLog(L"MXMesh : Trace exported to %s", filews.c_str());
+		return &true_value;
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.ExportTrace <json_file>"); return &false_value;
+	}
+}
+int LodFromArguments(Value** arg_list, int count)
+{
+	Value* lod = _get_key_arg(arg_list, count, Name::intern(L"lod"));
+	return lod == &unsupplied ? 0 : max(lod->to_int(), 0);
+}
+BYTE ChannelsFromValue(Value* value)
+{
+	// A Single Name Or An Array Of Names, Geometry Is Always Restored
+	vector<Value*> names;
+	if (is_array(value))
+	{
+		Array* items = (Array*)value;
+		for (int i = 0; i < items->size; i++) names.push_back(items->data[i]);
+	}
+	else names.push_back(value);
+
+	BYTE channels = RESTORE_CHANNEL_GEOMETRY;
+	for (Value* name : names)
+	{
+		auto option = name->to_string();
+		if (wcscmp(option, L"all") == 0) channels |= RESTORE_CHANNEL_ALL;
+		else if (wcscmp(option, L"uv") == 0 || wcscmp(option, L"uvs") == 0) channels |= RESTORE_CHANNEL_UVS;
+		else if (wcscmp(option, L"normals") == 0) channels |= RESTORE_CHANNEL_NORMALS;
+		else if (wcscmp(option, L"geometry") != 0) throw RuntimeError(L"Invalid Channel, Correct : [#geometry][#uv][#normals][#all]");
+	}
+	return channels;
+}
+BYTE ChannelsFromArguments(Value** arg_list, int count)
+{
+	Value* channels = _get_key_arg(arg_list, count, Name::intern(L"channels"));
+	return channels == &unsupplied ? RESTORE_CHANNEL_ALL : ChannelsFromValue(channels);
+}
+MaxMeshMXS(Restore, "Restore");
+Value* Restore_api(Value** arg_list, int count)
+{
+	if (count_with_keys() == 1)
+	{
+		const wchar_t* cacheFile = arg_list[0]->to_string();
+		Value* progressive = _get_key_arg(arg_list, count, Name::intern(L"progressive"));
+		int lod = LodFromArguments(arg_list, count);
+		BYTE channels = ChannelsFromArguments(arg_list, count);
+		bool restored = progressive != &unsupplied && progressive->to_bool() ?
+			GenerateProxyNodeFromCache(cacheFile, lod, channels) :
+			GenerateNodeFromCache(cacheFile, lod, channels);
+		if (restored) return &true_value;
+		else return &false_value;
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.Restore <cache_file> [lod:<level>] [channels:<#name|nameArray>] [progressive:<bool>]"); return &false_value;
+	}
+}
+MaxMeshMXS(FlushRestores, "FlushRestores");
+Value* FlushRestores_api(Value** arg_list, int count)
+{
+	if (count == 0)
+	{
+		// Blocks Until Every Progressive Restore Has Landed
+		profiler.Reset(); profiler.Start();
+		size_t swapped = FinishProgressiveRestores(true);
+		DebugLog(L"%d progressive restores flushed in %f ms.", (int)swapped, profiler.ElapsedMilliseconds());
+		return Integer::intern((int)swapped);
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : <integer> MXMesh.FlushRestores()"); return &false_value;
+	}
+}
+MaxMeshMXS(SetProgressiveWorkers, "SetProgressiveWorkers");
+Value* SetProgressiveWorkers_api(Value** arg_list, int count)
+{
+	if (count == 1)
+	{
+		progressiveWorkers = (size_t)max(arg_list[0]->to_int(), 1);
+		DebugLog(L"Progressive restores decode on up to %d workers.", (int)progressiveWorkers);
+		return &ok;
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.SetProgressiveWorkers <workers>"); return &false_value;
+	}
+}
+MaxMeshMXS(RestoreMesh, "RestoreMesh");
+Value* RestoreMesh_api(Value** arg_list, int count)
+{
+	if (count_with_keys() == 2)
+	{
+		const wchar_t* cacheFile = arg_list[0]->to_string();
+		if (GenerateNewPolyFromCache(cacheFile, NodesFromValue(arg_list[1]), LodFromArguments(arg_list, count), ChannelsFromArguments(arg_list, count))) return &true_value;
+		else return &false_value;
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.RestoreMesh <cache_file> <node|nodeArray> [lod:<level>] [channels:<#name|nameArray>]"); return &false_value;
+	}
+}
+MaxMeshMXS(AttachChannels, "AttachChannels");
+Value* AttachChannels_api(Value** arg_list, int count)
+{
+	if (count_with_keys() == 2)
+	{
+		const wchar_t* cacheFile = arg_list[0]->to_string();
+		if (AttachChannelsFromCache(cacheFile, arg_list[1]->to_node(), ChannelsFromArguments(arg_list, count))) return &true_value;
+		else return &false_value;
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.AttachChannels <cache_file> <node> [channels:<#name|nameArray>]"); return &false_value;
+	}
+}
+MaxMeshMXS(RestoreRegion, "RestoreRegion");
+Value* RestoreRegion_api(Value** arg_list, int count)
+{
+	if (count_with_keys() == 2)
+	{
+		const wchar_t* cacheFile = arg_list[0]->to_string();
+		if (GenerateRegionFromCache(cacheFile, arg_list[1]->to_box3(), ChannelsFromArguments(arg_list, count))) return &true_value;
+		else return &false_value;
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.RestoreRegion <cache_file> <world_box3> [channels:<#name|nameArray>]"); return &false_value;
+	}
+}
+MaxMeshMXS(RestoreFrame, "RestoreFrame");
+Value* RestoreFrame_api(Value** arg_list, int count)
+{
+	if (count == 3)
+	{
+		const wchar_t* cacheFile = arg_list[0]->to_string();
+		if (RestoreFrameFromCache(cacheFile, arg_list[1]->to_node(), arg_list[2]->to_int())) return &true_value;
+		else return &false_value;
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.RestoreFrame <cache_file> <node> <frame>"); return &false_value;
+	}
+}
+MaxMeshMXS(Play, "Play");
+Value* Play_api(Value** arg_list, int count)
+{
+	if (count == 2)
+	{
+		const wchar_t* cacheFile = arg_list[0]->to_string();
+		if (StartPlayback(cacheFile, arg_list[1]->to_node())) return &true_value;
+		else return &false_value;
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.Play <cache_file> <node>"); return &false_value;
+	}
+}
+MaxMeshMXS(StopPlayback, "StopPlayback");
+Value* StopPlayback_api(Value** arg_list, int count)
 {
-	// Get Temp Path
-	string tempAddr = filesystem::temp_directory_path().string();
-
-	// Return Storage Path
-	return tempAddr + "\\MXMeshStorage.mxo";
+	if (count == 0 || count == 1)
+	{
+		StopPlayback(count == 1 ? arg_list[0]->to_node() : nullptr);
+		return &ok;
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.StopPlayback [<node>]"); return &false_value;
+	}
 }
-bool CopyMeshToStorage(INode* node)
+MaxMeshMXS(SetPlaybackWindow, "SetPlaybackWindow");
+Value* SetPlaybackWindow_api(Value** arg_list, int count)
 {
-	if (!node) { return false; }
-	DebugLog(L"Copying object data [%s] storage mesh buffer...", node->GetName());
-
-	if (cacheBufferingMode == DISK_CACHE_BUFFERING_MODE)
-		DebugLog(L"Config `Cache Buffering Mode` = DISK_CACHE_BUFFERING_MODE");
-	if (cacheBufferingMode == MEMORY_CACHE_BUFFERING_MODE)
-		DebugLog(L"Config `Cache Buffering Mode` = MEMORY_CACHE_BUFFERING_MODE");
-
-	profiler.Reset(); profiler.Start();
-
-	TimeValue t = GetCOREInterface()->GetTime();
-	Object* obj = node->EvalWorldState(t).obj;
-
-	if (obj->CanConvertToType(triobjectCID))
+	if (count == 1 || count == 2)
 	{
-		// Get Tri Object
-		TriObject* tobj = (TriObject*)obj->ConvertToType(t, triobjectCID); if (!tobj) { return false; }
-
-		// Get Mesh
-		Mesh mesh = tobj->GetMesh();
-
-		// Compute Normals
-		mesh.SpecifyNormals();
-		MeshNormalSpec* mesh_ns = mesh.GetSpecifiedNormals();
-		mesh_ns->CheckNormals();
-
-		// Get Mesh Data Sizes
-		int vNum = mesh.numVerts;
-		int nNum = mesh_ns->GetNumNormals();
-		int fNum = mesh.numFaces;
-		int tNum = mesh.numTVerts;
-
-		MaxMeshMetaData meshMeta;
-		meshMeta.vNum = vNum;
-		meshMeta.nNum = nNum;
-		meshMeta.fNum = fNum;
-		meshMeta.tNum = tNum;
-
-		// Dump Information
-		sprintf_s(meshMeta.name, sizeof meshMeta.name, "%S", node->GetName());
-		meshMeta.col = node->GetWireColor();
-
-		// Dump Transformations
-		meshMeta.tm = node->GetObjTMAfterWSM(t);
-		decomp_affine(meshMeta.tm, &meshMeta.affine);
-		QuatToEuler(meshMeta.affine.q, meshMeta.rot);
-		meshMeta.pos.x = meshMeta.affine.t.x;
-		meshMeta.pos.y = meshMeta.affine.t.y;
-		meshMeta.pos.z = meshMeta.affine.t.z;
-		meshMeta.rot.x = RadToDeg_float(meshMeta.rot.x);
-		meshMeta.rot.y = RadToDeg_float(meshMeta.rot.y);
-		meshMeta.rot.z = RadToDeg_float(meshMeta.rot.z);
-		meshMeta.scale.x = meshMeta.affine.k.x;
-		meshMeta.scale.y = meshMeta.affine.k.y;
-		meshMeta.scale.z = meshMeta.affine.k.z;
-
-		// Get Temp Path
-		string tempAddr = filesystem::temp_directory_path().string();
-
-		// Dump Raw Buffers
-		if (cacheBufferingMode == DISK_CACHE_BUFFERING_MODE)
-		{
-			fileWritter.open(tempAddr + "\\max-mesh.vtx", ios::binary | ios::out);
-			fileWritter.write((char*)mesh.verts, vNum * sizeof(Point3));
-			fileWritter.close();
-
-			fileWritter.open(tempAddr + "\\max-mesh.tex", ios::binary | ios::out);
-			fileWritter.write((char*)mesh.tVerts, tNum * sizeof(UVVert));
-			fileWritter.close();
-
-			fileWritter.open(tempAddr + "\\max-mesh.idx", ios::binary | ios::out);
-			fileWritter.write((char*)mesh.faces, fNum * sizeof(Face));
-			fileWritter.close();
-
-			fileWritter.open(tempAddr + "\\max-mesh.tdx", ios::binary | ios::out);
-			fileWritter.write((char*)mesh.tvFace, fNum * sizeof(TVFace));
-			fileWritter.close();
-
-			fileWritter.open(tempAddr + "\\max-mesh.ndx", ios::binary | ios::out);
-			fileWritter.write((char*)mesh_ns->GetFaceArray(), fNum * sizeof(MeshNormalFace));
-			fileWritter.close();
-
-			fileWritter.open(tempAddr + "\\max-mesh.nrm", ios::binary | ios::out);
-			fileWritter.write((char*)mesh_ns->GetNormalArray(), nNum * sizeof(Point3));
-			fileWritter.close();
-
-			fileWritter.open(tempAddr + "\\max-mesh.mta", ios::binary | ios::out);
-			fileWritter.write((char*)&meshMeta, sizeof(MaxMeshMetaData));
-			fileWritter.close();
-		}
-		if (cacheBufferingMode == MEMORY_CACHE_BUFFERING_MODE)
+		playbackRingFrames = (size_t)max(arg_list[0]->to_int(), 1);
+		playbackLookahead = count == 2 ? (size_t)max(arg_list[1]->to_int(), 0) : playbackRingFrames / 4;
+		DebugLog(L"MXMesh : Playback keeps %d decoded frames, %d prefetched ahead. Applies to playbacks started from now on.",
+			(int)playbackRingFrames, (int)playbackLookahead);
+		return &ok;
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.SetPlaybackWindow <frames> [<lookahead>]"); return &false_value;
+	}
+}
+MaxMeshMXS(GetPlaybackStats, "GetPlaybackStats");
+Value* GetPlaybackStats_api(Value** arg_list, int count)
+{
+	if (count == 0)
+	{
+		// Rows Of #(node, cacheFile, frames, hits, misses, prefetched, resident, decodeMs, applyMsPerFrame)
+		one_typed_value_local(Array* result);
+		vl.result = new Array((int)playbacks.size());
+		for (auto& binding : playbacks)
 		{
-			vtxBuffer = stringstream(string(reinterpret_cast<char*>((char*)mesh.verts), vNum * sizeof(Point3)));
-			nrmBuffer = stringstream(string(reinterpret_cast<char*>((char*)mesh_ns->GetNormalArray()), nNum * sizeof(Point3)));
-			texBuffer = stringstream(string(reinterpret_cast<char*>((char*)mesh.tVerts), tNum * sizeof(UVVert)));
-			idxBuffer = stringstream(string(reinterpret_cast<char*>((char*)mesh.faces), fNum * sizeof(Face)));
-			tdxBuffer = stringstream(string(reinterpret_cast<char*>((char*)mesh.tvFace), fNum * sizeof(TVFace)));
-			ndxBuffer = stringstream(string(reinterpret_cast<char*>((char*)mesh_ns->GetFaceArray()), fNum * sizeof(MeshNormalFace)));
-			mtaBuffer = stringstream(string(reinterpret_cast<char*>((char*)&meshMeta), sizeof(MaxMeshMetaData)));
+			INode* node = maxInterface->GetINodeByHandle(binding->handle);
+			RingStats stats = binding->ring->Stats();
+			Array* row = new Array(9);
+			row->append(node ? (Value*)new String(node->GetName()) : &undefined);
+			row->append(new String(binding->file.c_str()));
+			row->append(Integer::intern((int)binding->view.FrameCount()));
+			row->append(Integer64::intern((INT64)stats.hits));
+			row->append(Integer64::intern((INT64)stats.misses));
+			row->append(Integer64::intern((INT64)stats.prefetched));
+			row->append(Integer::intern((int)stats.resident));
+			row->append(Float::intern((float)stats.decodeMilliseconds));
+			row->append(Float::intern((float)(binding->applied ? binding->applyMilliseconds / binding->applied : 0)));
+			vl.result->append(row);
 		}
-
-		// Remove Package If Exists
-		std::remove(GetStorageFilePath().c_str());
-
-		// Compressing
-		Zipper zipper(_strlwr((char*)GetStorageFilePath().c_str()));
-		if (cacheBufferingMode == DISK_CACHE_BUFFERING_MODE)
-		{
-			zipper.add(tempAddr + "\\max-mesh.vtx", compressionMode);
-			zipper.add(tempAddr + "\\max-mesh.nrm", compressionMode);
-			zipper.add(tempAddr + "\\max-mesh.tex", compressionMode);
-			zipper.add(tempAddr + "\\max-mesh.idx", compressionMode);
-			zipper.add(tempAddr + "\\max-mesh.tdx", compressionMode);
-			zipper.add(tempAddr + "\\max-mesh.ndx", compressionMode);
-			zipper.add(tempAddr + "\\max-mesh.mta", compressionMode);
-		}
-		if (cacheBufferingMode == MEMORY_CACHE_BUFFERING_MODE)
-		{
-			zipper.add(vtxBuffer, "max-mesh.vtx", compressionMode);
-			zipper.add(nrmBuffer, "max-mesh.nrm", compressionMode);
-			zipper.add(texBuffer, "max-mesh.tex", compressionMode);
-			zipper.add(idxBuffer, "max-mesh.idx", compressionMode);
-			zipper.add(tdxBuffer, "max-mesh.tdx", compressionMode);
-			zipper.add(ndxBuffer, "max-mesh.ndx", compressionMode);
-			zipper.add(mtaBuffer, "max-mesh.mta", compressionMode);
+		return_value(vl.result);
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : <array> MXMesh.GetPlaybackStats()"); return &false_value;
+	}
+}
+MaxMeshMXS(ListCheckpoints, "ListCheckpoints");
+Value* ListCheckpoints_api(Value** arg_list, int count)
+{
+	if (count == 0 || count == 1)
+	{
+		string filter;
+		if (count == 1)
+		{
+			wstring filterws(arg_list[0]->to_string());
+			filter = string(filterws.begin(), filterws.end());
 		}
-		zipper.close();
+		SyncCatalog(false);
 
-		// Clear Up
-		if (cacheBufferingMode == DISK_CACHE_BUFFERING_MODE) {
-			filesystem::remove(tempAddr + "\\max-mesh.vtx");
-			filesystem::remove(tempAddr + "\\max-mesh.nrm");
-			filesystem::remove(tempAddr + "\\max-mesh.tex");
-			filesystem::remove(tempAddr + "\\max-mesh.idx");
-			filesystem::remove(tempAddr + "\\max-mesh.tdx");
-			filesystem::remove(tempAddr + "\\max-mesh.ndx");
-			filesystem::remove(tempAddr + "\\max-mesh.mta");
-		}
-		if (cacheBufferingMode == MEMORY_CACHE_BUFFERING_MODE) {
-			vtxBuffer.clear(); stringstream().swap(vtxBuffer);
-			nrmBuffer.clear(); stringstream().swap(nrmBuffer);
-			texBuffer.clear(); stringstream().swap(texBuffer);
-			idxBuffer.clear(); stringstream().swap(idxBuffer);
-			tdxBuffer.clear(); stringstream().swap(tdxBuffer);
-			ndxBuffer.clear(); stringstream().swap(ndxBuffer);
-			mtaBuffer.clear(); stringstream().swap(mtaBuffer);
-		}
-
-		DebugLog(L"Object [%s] mesh data successfully copied in %f ms", node->GetName(), profiler.ElapsedMilliseconds());
-		return true;
+		// Package Names Without Extension, Sorted
+		auto listed = catalog.List(filter.c_str());
+		one_typed_value_local(Array* result);
+		vl.result = new Array((int)listed.size());
+		for (auto record : listed)
+			vl.result->append(new String(StringGetWideChar(path(record->file).stem().string().c_str())));
+		return_value(vl.result);
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : <array> MXMesh.ListCheckpoints [filter]"); return &false_value;
 	}
-
-	DebugLog(L"Copying object [%s] mesh data failed.", node->GetName());
-	return false;
 }
-bool PasteMeshFromStorage(INode* node)
+MaxMeshMXS(GetCheckpointInfo, "GetCheckpointInfo");
+Value* GetCheckpointInfo_api(Value** arg_list, int count)
 {
-	string storageFilePath = GetStorageFilePath();
-	wstring storageFilePathWS(storageFilePath.begin(), storageFilePath.end());
-	return GenerateNewPolyFromCache(storageFilePathWS.c_str(), node);
-}
+	if (count == 1)
+	{
+		string file = CatalogFileName(arg_list[0]->to_string());
+		SyncCatalog(false);
+		const CatalogRecord* record = catalog.Find(file.c_str());
+		if (!record) return &undefined;
 
-// Maxscript Exposed API
-MaxMeshMXS(Cache, "Cache");
-Value* Cache_api(Value** arg_list, int count)
+		char timeBuffer[32] = {};
+		time_t timestamp = (time_t)record->timestamp;
+		strftime(timeBuffer, sizeof timeBuffer, "%Y-%m-%d %H:%M:%S", localtime(&timestamp));
+
+		// Rows Of #(#name, value)
+		pair<const wchar_t*, Value*> fields[] = {
+			{ L"node", new String(StringGetWideChar(record->node)) },
+			{ L"time", new String(StringGetWideChar(timeBuffer)) },
+			{ L"vertices", Integer::intern(record->vNum) },
+			{ L"faces", Integer::intern(record->fNum) },
+			{ L"bboxMin", new Point3Value(Point3(record->bboxMin[0], record->bboxMin[1], record->bboxMin[2])) },
+			{ L"bboxMax", new Point3Value(Point3(record->bboxMax[0], record->bboxMax[1], record->bboxMax[2])) },
+			{ L"packageSize", Integer64::intern((INT64)record->packageSize) },
+			{ L"rawSize", Integer64::intern((INT64)record->rawSize) },
+			{ L"fingerprint", Integer64::intern((INT64)record->fingerprint) } };
+
+		one_typed_value_local(Array* result);
+		vl.result = new Array((int)size(fields));
+		for (auto& field : fields)
+		{
+			Array* row = new Array(2);
+			row->append(Name::intern(field.first));
+			row->append(field.second);
+			vl.result->append(row);
+		}
+		return_value(vl.result);
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : <array> MXMesh.GetCheckpointInfo <name>"); return &false_value;
+	}
+}
+MaxMeshMXS(DeleteCheckpoint, "DeleteCheckpoint");
+Value* DeleteCheckpoint_api(Value** arg_list, int count)
 {
 	if (count == 1)
 	{
-		INode* node = arg_list[0]->to_node();
-		if (CacheMeshToDisk(node)) return &true_value;
+		string file = CatalogFileName(arg_list[0]->to_string());
+		if (RemoveCatalogPackage(file.c_str())) return &true_value;
 		else return &false_value;
 	}
 	else
 	{
-		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.Cache <node>"); return &false_value;
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.DeleteCheckpoint <name>"); return &false_value;
 	}
 }
-MaxMeshMXS(Checkpoint, "Checkpoint");
-Value* Checkpoint_api(Value** arg_list, int count)
+MaxMeshMXS(PinCheckpoint, "PinCheckpoint");
+Value* PinCheckpoint_api(Value** arg_list, int count)
 {
-	if (count == 1)
+	if (count == 1 || count == 2)
 	{
-		INode* node = arg_list[0]->to_node();
-		if (CacheMeshToDisk(node, true)) return &true_value;
-		else return &false_value;
+		string file = CatalogFileName(arg_list[0]->to_string());
+		bool pinned = count == 2 ? arg_list[1]->to_bool() : true;
+		SyncCatalog(false);
+		CatalogRecord* record = catalog.Find(file.c_str());
+		if (!record) return &false_value;
+
+		if (pinned) record->flags |= RecordPinned;
+		else record->flags &= ~RecordPinned;
+		catalog.Save(); catalogDirty = false;
+		catalogFolderStamp = CatalogFolderStamp();
+		return &true_value;
 	}
 	else
 	{
-		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.Cache <node>"); return &false_value;
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.PinCheckpoint <name> [<pinned>]"); return &false_value;
 	}
 }
-MaxMeshMXS(SetCachePath, "SetCachePath");
-Value* SetCachePath_api(Value** arg_list, int count)
+MaxMeshMXS(SetCacheQuota, "SetCacheQuota");
+Value* SetCacheQuota_api(Value** arg_list, int count)
 {
-	if (count == 1)
+	if (count == 1 || count == 2)
 	{
-		const wchar_t* cachePathVal = arg_list[0]->to_string();
-		wstring cachePathValws(cachePathVal);
-		cachePath = string(cachePathValws.begin(), cachePathValws.end());
+		int limitMB = max(arg_list[0]->to_int(), 0);
+		int limitCount = count == 2 ? max(arg_list[1]->to_int(), 0) : 0;
+		SyncCatalog(false);
 
-		DebugLog(L"MXMesh cache path has been set to `%s`\n", cachePathVal);
+		// Stored In The Catalog, Each Cache Path Keeps Its Own Quota
+		CatalogQuota quota = {};
+		quota.bytes = (uint64_t)limitMB << 20;
+		quota.count = (uint32_t)limitCount;
+		catalog.SetQuota(quota);
+		catalog.Save(); catalogDirty = false;
+		catalogFolderStamp = CatalogFolderStamp();
+		if (IsOverQuota()) ScheduleCacheSweep();
+
+		DebugLog(L"MXMesh : Cache quota has been set to %d MB, %d package(s) (0 = unlimited).", limitMB, limitCount);
 		return &ok;
 	}
 	else
 	{
-		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.SetCachePath <path>"); return &false_value;
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.SetCacheQuota <megabytes> [<count>]"); return &false_value;
 	}
 }
-MaxMeshMXS(GetCachePath, "GetCachePath");
-Value* GetCachePath_api(Value** arg_list, int count)
+MaxMeshMXS(GetCacheQuota, "GetCacheQuota");
+Value* GetCacheQuota_api(Value** arg_list, int count)
 {
 	if (count == 0)
 	{
-		String* _str = new String(StringGetWideChar(cachePath.c_str()));
-		return _str;
+		SyncCatalog(false);
+		const CatalogQuota& quota = catalog.Quota();
+
+		// #(megabytes, count, usedMegabytes, usedCount)
+		one_typed_value_local(Array* result);
+		vl.result = new Array(4);
+		vl.result->append(Integer::intern((int)(quota.bytes >> 20)));
+		vl.result->append(Integer::intern((int)quota.count));
+		vl.result->append(Integer::intern((int)(catalog.TotalSize() >> 20)));
+		vl.result->append(Integer::intern((int)catalog.Records().size()));
+		return_value(vl.result);
 	}
 	else
 	{
-		throw RuntimeError(L"Invalid Inputs, Correct : <string> MXMesh.GetCachePath()"); return &false_value;
+		throw RuntimeError(L"Invalid Inputs, Correct : <array> MXMesh.GetCacheQuota()"); return &false_value;
 	}
 }
-MaxMeshMXS(Restore, "Restore");
-Value* Restore_api(Value** arg_list, int count)
+MaxMeshMXS(SweepCache, "SweepCache");
+Value* SweepCache_api(Value** arg_list, int count)
 {
-	if (count == 1)
+	if (count == 0)
 	{
-		const wchar_t* cacheFile = arg_list[0]->to_string();
-		if (GenerateNodeFromCache(cacheFile)) return &true_value;
-		else return &false_value;
+		// Whole Catalog In One Pass
+		size_t evicted = 0;
+		SyncCatalog(false);
+		SweepCacheStep(catalog.Records().size(), SIZE_MAX, evicted);
+		return Integer::intern((int)evicted);
 	}
 	else
 	{
-		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.Restore <cache_file>"); return &false_value;
+		throw RuntimeError(L"Invalid Inputs, Correct : <integer> MXMesh.SweepCache()"); return &false_value;
 	}
 }
-MaxMeshMXS(RestoreMesh, "RestoreMesh");
-Value* RestoreMesh_api(Value** arg_list, int count)
+MaxMeshMXS(RebuildCatalog, "RebuildCatalog");
+Value* RebuildCatalog_api(Value** arg_list, int count)
 {
-	if (count == 2)
+	if (count == 0)
 	{
-		const wchar_t* cacheFile = arg_list[0]->to_string();
-		INode* caheNode = arg_list[1]->to_node();
-		if (GenerateNewPolyFromCache(cacheFile, caheNode)) return &true_value;
-		else return &false_value;
+		profiler.Reset(); profiler.Start();
+		SyncCatalog(true);
+		DebugLog(L"Checkpoint catalog rebuilt in %f ms", profiler.ElapsedMilliseconds());
+		return Integer::intern((int)catalog.Records().size());
 	}
 	else
 	{
-		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.RestoreMesh <cache_file> <node>"); return &false_value;
+		throw RuntimeError(L"Invalid Inputs, Correct : <integer> MXMesh.RebuildCatalog()"); return &false_value;
 	}
 }
 MaxMeshMXS(Purge, "Purge");
@@ -858,12 +5047,29 @@ Value* Purge_api(Value** arg_list, int count)
 	if (count == 0)
 	{
 		ExecuteMAXScriptScript(L"gc()", MAXScript::ScriptSource::NonEmbedded, TRUE);
+		bufferPool.Trim();
+		migrationQueue.Flush();
+		memoryTier.Clear();
+		SyncCatalog(false);
+		if (IsStagingEnabled())
+			for (auto const& entry : directory_iterator(path(stagingPath)))
+			{
+				// Only Copies Of This Cache Folder, Other Projects Share The Staging Folder
+				string ext = entry.path().extension().string(); String2Lower(ext);
+				StagedOrigin origin;
+				if (!entry.is_regular_file() || ext != ".mxo" || !ReadStagedOrigin(entry.path(), origin) ||
+					!IsInCacheFolder(origin.archive) || IsPinnedPackage(origin.archive)) continue;
+				filesystem::remove(entry);
+				filesystem::remove(StagedOriginPath(entry.path()));
+			}
 		if (filesystem::exists(cachePath) && filesystem::is_directory(cachePath))
 			for (auto const& entry : filesystem::recursive_directory_iterator(cachePath)) 
 			{
 				string ext = entry.path().extension().string(); String2Lower(ext);
-				if (filesystem::is_regular_file(entry) && ext == ".mxo") filesystem::remove(entry);
+				if (!filesystem::is_regular_file(entry) || (ext != ".mxo" && ext != ".mxa") || IsPinnedPackage(entry.path())) continue;
+				filesystem::remove(entry);
 			}
+		SyncCatalog(false);
 		return &ok;
 	}
 	else
@@ -887,11 +5093,255 @@ Value* SetRestoreMode_api(Value** arg_list, int count)
 			DebugLog(L"MXMesh : Restoring Mode has been set to multi thread mode.");
 			return &ok;
 		}
+		if (wcscmp(option, L"auto") == 0) {
+			restoreMode = RESTORE_CACHE_MODE_AUTO;
+			DebugLog(L"MXMesh : Restoring Mode has been set to automatic mode.");
+			return &ok;
+		}
+		return &false_value;
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.SetRestoreMode [#single][#multi][#auto]"); return &false_value;
+	}
+}
+MaxMeshMXS(CalibrateRestore, "CalibrateRestore");
+Value* CalibrateRestore_api(Value** arg_list, int count)
+{
+	if (count == 0)
+	{
+		DebugLog(L"Calibrating restore copy kernels...");
+		vector<Sample> samples;
+		copyCalibration = Calibrate(samples);
+		copyCalibrated = true;
+		SaveCalibration();
+
+		DebugLog(L"Calibration : grain %llu KB, parallel from %llu KB, streaming from %llu KB.",
+			(unsigned long long)(copyCalibration.grainSize >> 10),
+			(unsigned long long)(copyCalibration.parallelThreshold >> 10),
+			(unsigned long long)(copyCalibration.streamThreshold >> 10));
+
+		// Rows Of #(sizeKB, memcpyMBps, parallelMBps, streamMBps)
+		one_typed_value_local(Array* result);
+		vl.result = new Array((int)samples.size());
+		for (auto& sample : samples)
+		{
+			Array* row = new Array(4);
+			row->append(Integer::intern((int)(sample.size >> 10)));
+			row->append(Float::intern((float)sample.memcpyMBps));
+			row->append(Float::intern((float)sample.parallelMBps));
+			row->append(Float::intern((float)sample.streamMBps));
+			vl.result->append(row);
+		}
+		return_value(vl.result);
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : <array> MXMesh.CalibrateRestore()"); return &false_value;
+	}
+}
+MaxMeshMXS(SetRestoreMemoryLimit, "SetRestoreMemoryLimit");
+Value* SetRestoreMemoryLimit_api(Value** arg_list, int count)
+{
+	if (count == 1)
+	{
+		int limitMB = arg_list[0]->to_int();
+		restoreMemoryLimit = limitMB > 0 ? (size_t)limitMB << 20 : 0;
+		DebugLog(L"MXMesh : Restore memory limit has been set to %d MB (0 = unlimited).", max(limitMB, 0));
+		return &ok;
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.SetRestoreMemoryLimit <megabytes>"); return &false_value;
+	}
+}
+MaxMeshMXS(GetRestoreMemoryLimit, "GetRestoreMemoryLimit");
+Value* GetRestoreMemoryLimit_api(Value** arg_list, int count)
+{
+	if (count == 0)
+	{
+		return Integer::intern((int)(restoreMemoryLimit >> 20));
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : <integer> MXMesh.GetRestoreMemoryLimit()"); return &false_value;
+	}
+}
+MaxMeshMXS(SetOperationMemoryLimit, "SetOperationMemoryLimit");
+Value* SetOperationMemoryLimit_api(Value** arg_list, int count)
+{
+	if (count == 1)
+	{
+		int limitMB = max(arg_list[0]->to_int(), 0);
+		memoryLedger.SetOperationLimit((uint64_t)limitMB << 20);
+		DebugLog(L"MXMesh : Operation memory limit has been set to %d MB (0 = unlimited).", limitMB);
+		return &ok;
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.SetOperationMemoryLimit <megabytes>"); return &false_value;
+	}
+}
+MaxMeshMXS(GetOperationMemoryLimit, "GetOperationMemoryLimit");
+Value* GetOperationMemoryLimit_api(Value** arg_list, int count)
+{
+	if (count == 0)
+	{
+		return Integer::intern((int)(memoryLedger.OperationLimit() >> 20));
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : <integer> MXMesh.GetOperationMemoryLimit()"); return &false_value;
+	}
+}
+MaxMeshMXS(GetMemoryStats, "GetMemoryStats");
+Value* GetMemoryStats_api(Value** arg_list, int count)
+{
+	if (count == 0)
+	{
+		LedgerStats stats = memoryLedger.Stats();
+		auto row = [](const wchar_t* key, Value* value) { Array* pair = new Array(2); pair->append(Name::intern(key)); pair->append(value); return pair; };
+
+		// Rows Of #(#name, value), Categories As #(#name, #(current, peak, operationPeak))
+		one_typed_value_local(Array* result);
+		vl.result = new Array(6 + CategoryCount);
+		vl.result->append(row(L"current", Integer64::intern((INT64)stats.current)));
+		vl.result->append(row(L"peak", Integer64::intern((INT64)stats.peak)));
+		vl.result->append(row(L"operationCurrent", Integer64::intern((INT64)stats.operationCurrent)));
+		vl.result->append(row(L"operationPeak", Integer64::intern((INT64)stats.operationPeak)));
+		vl.result->append(row(L"operationLimit", Integer64::intern((INT64)stats.operationLimit)));
+		vl.result->append(row(L"refused", Integer64::intern((INT64)stats.refused)));
+		for (int c = 0; c < CategoryCount; c++)
+		{
+			string category = CategoryName((Category)c);
+			Array* usage = new Array(3);
+			usage->append(Integer64::intern((INT64)stats.categories[c].current));
+			usage->append(Integer64::intern((INT64)stats.categories[c].peak));
+			usage->append(Integer64::intern((INT64)stats.categories[c].operationPeak));
+			vl.result->append(row(wstring(category.begin(), category.end()).c_str(), usage));
+		}
+		return_value(vl.result);
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : <array> MXMesh.GetMemoryStats()"); return &false_value;
+	}
+}
+MaxMeshMXS(SetBufferPoolLimit, "SetBufferPoolLimit");
+Value* SetBufferPoolLimit_api(Value** arg_list, int count)
+{
+	if (count == 1)
+	{
+		int limitMB = max(arg_list[0]->to_int(), 0);
+		bufferPool.SetRetentionLimit((size_t)limitMB << 20);
+		DebugLog(L"MXMesh : Buffer pool retention limit has been set to %d MB.", limitMB);
+		return &ok;
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.SetBufferPoolLimit <megabytes>"); return &false_value;
+	}
+}
+MaxMeshMXS(GetBufferPoolStats, "GetBufferPoolStats");
+Value* GetBufferPoolStats_api(Value** arg_list, int count)
+{
+	if (count == 0)
+	{
+		PoolStats stats = bufferPool.Stats();
+		pair<const wchar_t*, INT64> fields[] = {
+			{ L"hits", (INT64)stats.hits },
+			{ L"misses", (INT64)stats.misses },
+			{ L"releases", (INT64)stats.releases },
+			{ L"evictions", (INT64)stats.evictions },
+			{ L"retainedBytes", (INT64)stats.retainedBytes },
+			{ L"peakRetainedBytes", (INT64)stats.peakRetainedBytes },
+			{ L"retentionLimit", (INT64)stats.retentionLimit } };
+
+		// Rows Of #(#name, value)
+		one_typed_value_local(Array* result);
+		vl.result = new Array((int)size(fields));
+		for (auto& field : fields)
+		{
+			Array* row = new Array(2);
+			row->append(Name::intern(field.first));
+			row->append(Integer64::intern(field.second));
+			vl.result->append(row);
+		}
+		return_value(vl.result);
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : <array> MXMesh.GetBufferPoolStats()"); return &false_value;
+	}
+}
+MaxMeshMXS(GetProcessMemory, "GetProcessMemory");
+Value* GetProcessMemory_api(Value** arg_list, int count)
+{
+	if (count == 0)
+	{
+		PROCESS_MEMORY_COUNTERS counters = {};
+		counters.cb = sizeof(counters);
+		if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return &undefined;
+
+		pair<const wchar_t*, INT64> fields[] = {
+			{ L"workingSet", (INT64)counters.WorkingSetSize },
+			{ L"peakWorkingSet", (INT64)counters.PeakWorkingSetSize },
+			{ L"pagefile", (INT64)counters.PagefileUsage },
+			{ L"peakPagefile", (INT64)counters.PeakPagefileUsage } };
+
+		// Rows Of #(#name, value)
+		one_typed_value_local(Array* result);
+		vl.result = new Array((int)size(fields));
+		for (auto& field : fields)
+		{
+			Array* row = new Array(2);
+			row->append(Name::intern(field.first));
+			row->append(Integer64::intern(field.second));
+			vl.result->append(row);
+		}
+		return_value(vl.result);
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : <array> MXMesh.GetProcessMemory()"); return &false_value;
+	}
+}
+MaxMeshMXS(TrimBufferPool, "TrimBufferPool");
+Value* TrimBufferPool_api(Value** arg_list, int count)
+{
+	if (count == 0)
+	{
+		bufferPool.Trim();
+		bufferPool.ResetStats();
+		DebugLog(L"MXMesh : Buffer pool has been trimmed.");
+		return &ok;
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.TrimBufferPool()"); return &false_value;
+	}
+}
+MaxMeshMXS(SetRestoreTarget, "SetRestoreTarget");
+Value* SetRestoreTarget_api(Value** arg_list, int count)
+{
+	if (count == 1)
+	{
+		auto option = arg_list[0]->to_string();
+		if (wcscmp(option, L"poly") == 0) {
+			restoreTarget = RESTORE_TARGET_EDITABLE_POLY;
+			DebugLog(L"MXMesh : Restore Target has been set to editable poly.");
+			return &ok;
+		}
+		if (wcscmp(option, L"mesh") == 0) {
+			restoreTarget = RESTORE_TARGET_EDITABLE_MESH;
+			DebugLog(L"MXMesh : Restore Target has been set to editable mesh.");
+			return &ok;
+		}
 		return &false_value;
 	}
 	else
 	{
-		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.SetRestoreMode [#single][#multi]"); return &false_value;
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.SetRestoreTarget [#poly][#mesh]"); return &false_value;
 	}
 }
 MaxMeshMXS(SetCacheBufferingMode, "SetCacheBufferingMode");
@@ -917,6 +5367,29 @@ Value* SetCacheBufferingMode_api(Value** arg_list, int count)
 		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.SetCacheBufferingMode [#disk][#memory]"); return &false_value;
 	}
 }
+MaxMeshMXS(SetCacheTopologyMode, "SetCacheTopologyMode");
+Value* SetCacheTopologyMode_api(Value** arg_list, int count)
+{
+	if (count == 1)
+	{
+		auto option = arg_list[0]->to_string();
+		if (wcscmp(option, L"poly") == 0) {
+			cacheTopologyMode = CACHE_TOPOLOGY_MODE_POLY;
+			DebugLog(L"MXMesh : Cache Topology Mode has been set to native polygon mode.");
+			return &ok;
+		}
+		if (wcscmp(option, L"tri") == 0) {
+			cacheTopologyMode = CACHE_TOPOLOGY_MODE_TRI;
+			DebugLog(L"MXMesh : Cache Topology Mode has been set to triangle mode.");
+			return &ok;
+		}
+		return &false_value;
+	}
+	else
+	{
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.SetCacheTopologyMode [#poly][#tri]"); return &false_value;
+	}
+}
 MaxMeshMXS(SetCompressionMode, "SetCompressionMode");
 Value* SetCompressionMode_api(Value** arg_list, int count)
 {
@@ -933,11 +5406,16 @@ Value* SetCompressionMode_api(Value** arg_list, int count)
 			DebugLog(L"MXMesh : Compression Mode has been set to better.");
 			return &ok;
 		}
+		if (wcscmp(option, L"store") == 0) {
+			compressionMode = Zipper::Store;
+			DebugLog(L"MXMesh : Compression Mode has been set to store.");
+			return &ok;
+		}
 		return &false_value;
 	}
 	else
 	{
-		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.SetCompressionMode [#faster][#better]"); return &false_value;
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.SetCompressionMode [#faster][#better][#store]"); return &false_value;
 	}
 }
 MaxMeshMXS(CopyMesh, "CopyMesh");
@@ -946,7 +5424,7 @@ Value* CopyMesh_api(Value** arg_list, int count)
 	if (count == 1)
 	{
 		INode* node = arg_list[0]->to_node();
-		if (CopyMeshToStorage(node)) return &true_value;
+		if (CopyMeshToClipboard(node)) return &true_value;
 		else return &false_value;
 	}
 	else
@@ -959,13 +5437,12 @@ Value* PasteMesh_api(Value** arg_list, int count)
 {
 	if (count == 1)
 	{
-		INode* node = arg_list[0]->to_node();
-		if (PasteMeshFromStorage(node)) return &true_value;
+		if (PasteMeshFromClipboard(NodesFromValue(arg_list[0]))) return &true_value;
 		else return &false_value;
 	}
 	else
 	{
-		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.PasteMesh <node>"); return &false_value;
+		throw RuntimeError(L"Invalid Inputs, Correct : MXMesh.PasteMesh <node|nodeArray>"); return &false_value;
 	}
 }
 MaxMeshMXS(SetDebugMode, "SetDebugMode");
@@ -1002,11 +5479,22 @@ extern "C" __declspec(dllexport) ULONG LibVersion()
 extern "C" __declspec(dllexport) int LibInitialize(void)
 {
 	maxInterface = GetCOREInterface();
+	mainThreadId = this_thread::get_id();
 	cachePath = filesystem::temp_directory_path().string();
+	LoadCalibration();
+	GlobalTracer().SetThreadName("3ds Max");
+	opStats.AttachLedger(&memoryLedger);
+	opStats.SetListener(LogOperationMemory);
 	return TRUE;
 }
 extern "C" __declspec(dllexport) int LibShutdown(void)
 {
+	if (cacheSweepTimer) KillTimer(NULL, cacheSweepTimer);
+	if (playbackReleaseTimer) KillTimer(NULL, playbackReleaseTimer);
+	StopPlayback(nullptr);
+	CancelProgressiveRestores();
+	migrationQueue.Stop();
+	if (catalogDirty) catalog.Save();
 	return TRUE;
 }
 extern "C" __declspec(dllexport) ULONG CanAutoDefer()